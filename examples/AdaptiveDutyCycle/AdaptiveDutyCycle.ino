@@ -0,0 +1,63 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_DutyCycle.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+RYUW122_DutyCycleController dutyCycle(uwb);
+
+void setup() {
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Adaptive duty cycle");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN);
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  RYUW122_DutyCycleConfig config;
+  config.targetRate = 2.0f;            // The anchor needs 2 ranges per second from this tag
+  config.minWriteInterval = 600000;    // Change AT+TAGD at most every 10 minutes while the rate is held
+  config.flashWriteBudget = 200;
+
+  uwb.setMode(MODE_TAG);
+  dutyCycle.begin(config); // Reads the current AT+TAGD windows
+}
+
+void loop() {
+  RYUW122_MessageInfo info;
+
+  if (dutyCycle.receive(info) == MESSAGE_RECEIVED) {
+    // The UART has just answered, a good moment to write new windows
+    RYUW122_DutyCycleState state = dutyCycle.update();
+
+    if (state != DUTY_MEASURING && state != DUTY_STABLE) {
+      Serial.print("State: ");
+      Serial.print(state);
+      Serial.print(", windows: ");
+      Serial.print(dutyCycle.getEnableTime());
+      Serial.print(" / ");
+      Serial.print(dutyCycle.getDisableTime());
+      Serial.print(" ms, duty: ");
+      Serial.print(dutyCycle.getDutyCycle() * 100.0f);
+      Serial.print(" %, poll period: ");
+      Serial.print(dutyCycle.getPollPeriod());
+      Serial.print(" ms, rate: ");
+      Serial.print(dutyCycle.getSuccessRate());
+      Serial.print(" Hz, missed: ");
+      Serial.print(dutyCycle.getMissedPollRate() * 100.0f);
+      Serial.print(" %, RF on time per range: ");
+      Serial.print(dutyCycle.getEnergyPerRange() * 1000.0f);
+      Serial.println(" ms");
+    }
+  }
+}
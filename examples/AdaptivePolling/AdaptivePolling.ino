@@ -0,0 +1,71 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_PollScheduler.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+// Create UWB object using hardware Serial1
+RYUW122_UWB uwb(Serial1);
+
+// Moving tags are polled up to every 100 ms, stationary ones at least once per second
+RYUW122_PollScheduler scheduler;
+
+const char *tags[] = {"DAVID123", "TAG2", "TAG3", "TAG4"};
+
+void setup() {
+  delay(500);
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Adaptive Polling");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN); // Hardware reset is recommended
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  for (const char *tag : tags) {
+    scheduler.addTag(RYUW122_Address::fromChars(tag), millis());
+  }
+}
+
+RYUW122_Address polledTag;
+
+void loop() {
+  RYUW122_MessageInfo info;
+
+  if (!uwb.isAsyncMessageSend()) {
+    // Poll the tag with the earliest deadline once it is due
+    if (scheduler.next(polledTag, millis())) {
+      uwb.sendMessageAsync(polledTag, "DST");
+    }
+    return;
+  }
+
+  switch (uwb.receiveMessageAsyncAnchor(info)) {
+    case MESSAGE_RECEIVED:
+      scheduler.reportRange(info, millis());
+      Serial.print(info.address);
+      Serial.print(": ");
+      Serial.print(info.distance);
+      Serial.print(" cm, ");
+      Serial.print(scheduler.getSpeed(polledTag));
+      Serial.print(" cm/s, next poll in ");
+      Serial.print(scheduler.getInterval(polledTag));
+      Serial.println(" ms");
+      break;
+
+    case MESSAGE_WAITING:
+      break;
+
+    default:
+      scheduler.reportTimeout(polledTag, millis());
+      break;
+  }
+}
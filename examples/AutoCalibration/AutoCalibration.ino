@@ -0,0 +1,55 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_Calibration.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+RYUW122_Calibrator calibrator(uwb);
+
+void setup() {
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Automatic distance calibration");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN); // Hardware reset is recommended
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  // Module must be in anchor mode, tag "DAVID123" placed exactly 2 m away
+  RYUW122_CalibrationConfig config;
+  config.referenceDistance = 200;   // cm
+  config.confidenceHalfWidth = 1.0; // Stop once the mean is known within +-1 cm (95 %)
+
+  if (!calibrator.begin("DAVID123", config)) {
+    Serial.println("Cannot read current calibration");
+    return;
+  }
+
+  RYUW122_CalibrationState state = calibrator.run();
+  const RYUW122_CalibrationResult &result = calibrator.getResult();
+
+  Serial.print("State: ");
+  Serial.println(state);
+  Serial.print("Offset: ");
+  Serial.print(result.previousOffset);
+  Serial.print(" -> ");
+  Serial.println(result.offset);
+  Serial.print("Residual [cm]: ");
+  Serial.println(result.residual);
+  Serial.print("Samples used / rejected: ");
+  Serial.print(result.samplesUsed);
+  Serial.print(" / ");
+  Serial.println(result.samplesRejected);
+}
+
+void loop() {
+}
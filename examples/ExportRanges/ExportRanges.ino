@@ -0,0 +1,63 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_Exporter.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+// Binary frames are decoded on the host with extras/export/ryuw122_export_decode, line protocol can be piped into InfluxDB as is
+#define EXPORT_FORMAT EXPORT_BINARY
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+RYUW122_Exporter exporter(Serial);
+
+const RYUW122_Address TAGS[] = {"TAG1", "TAG2", "TAG3"};
+const uint8_t TAG_COUNT = sizeof(TAGS) / sizeof(TAGS[0]);
+
+uint8_t currentTag = 0;
+bool polling = false;
+
+void setup() {
+  Serial.begin(921600); // Export link, the decoder skips the text printed before the first frame
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Export ranges");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN);
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  RYUW122_ExporterConfig config;
+  config.format = EXPORT_FORMAT;
+  config.flushInterval = 50; // Latency limit, full batches are written earlier
+  config.anchor = "anchor1";
+  exporter.begin(config);
+
+  // Line protocol carries no timestamp until the Unix time is known, InfluxDB then stamps the arrival.
+  // With a clock (NTP, RTC) the lines carry Unix milliseconds, write them with precision=ms:
+  // exporter.setEpochTime(time(nullptr), millis());
+}
+
+void loop() {
+  // Poll the tags round robin, every range goes into the current batch
+  if (!polling) {
+    polling = uwb.sendMessageAsync(TAGS[currentTag], "R");
+    if (!polling) currentTag = (currentTag + 1) % TAG_COUNT;
+  } else {
+    RYUW122_MessageInfo info;
+    RYUW122_MessageState state = uwb.receiveMessageAsyncAnchor(info);
+    if (state != MESSAGE_WAITING) {
+      if (state == MESSAGE_RECEIVED) exporter.add(info, millis());
+      polling = false;
+      currentTag = (currentTag + 1) % TAG_COUNT;
+    }
+  }
+
+  exporter.update(millis()); // Writes a batch whose oldest range reached the flush interval
+}
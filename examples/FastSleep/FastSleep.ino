@@ -0,0 +1,55 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_Power.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+RYUW122_PowerManager power(uwb);
+
+const char *TAG_ADDRESS = "TAG1";
+
+void setup() {
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Fast sleep / wake");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN); // Without a reset pin every sleep writes flash
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  power.begin();
+  power.setMode(MODE_ANCHOR); // Written only when the module is not an anchor yet
+}
+
+void loop() {
+  // Survey burst: a few ranges, then rest
+  for (int i = 0; i < 5; i++) {
+    RYUW122_MessageInfo info;
+    if (uwb.sendMessage(TAG_ADDRESS, "R") && uwb.receiveMessage(info)) {
+      Serial.print("Distance: ");
+      Serial.print(info.distance);
+      Serial.println(" cm");
+    }
+  }
+
+  power.sleep();
+  delay(10000);
+
+  if (power.wake()) {
+    Serial.print("Woke in ");
+    Serial.print(power.getLastWakeTime());
+    Serial.print(" us, flash writes: ");
+    Serial.println(power.getFlashWrites());
+  } else {
+    Serial.println("Module did not wake up");
+  }
+}
@@ -0,0 +1,84 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_Arbiter.h>
+
+// ESP32 example: two FreeRTOS tasks share one anchor module through RYUW122_Arbiter.
+// Only the worker task touches the module, the other tasks submit requests and wait for them.
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+RYUW122_UWB uwb(Serial1);
+RYUW122_Arbiter arbiter(uwb);
+
+void workerTask(void *) {
+  for (;;) {
+    arbiter.process();
+    vTaskDelay(1);
+  }
+}
+
+void rangingTask(void *) {
+  RYUW122_RangeRequest request;
+  request.tag = "DAVID123";
+  request.message = "DST";
+
+  for (;;) {
+    if (arbiter.submit(request) && request.wait()) {
+      if (request.state == MESSAGE_RECEIVED) {
+        Serial.print("Distance: ");
+        Serial.print(request.info.distance);
+        Serial.println(" cm");
+      } else {
+        Serial.println("No response from tag");
+      }
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+  }
+}
+
+bool readNetworkID(RYUW122_UWB &module, void *buffer) {
+  return module.getNetworkID((char *)buffer, 9);
+}
+
+void statusTask(void *) {
+  char networkID[9];
+  RYUW122_ConfigRequest request;
+  request.operation = readNetworkID;
+  request.argument = networkID;
+
+  for (;;) {
+    // Configuration requests wait while ranging requests are queued
+    if (arbiter.submit(request) && request.wait(2000) && request.success) {
+      Serial.print("Network ID: ");
+      Serial.println(networkID);
+    }
+    vTaskDelay(pdMS_TO_TICKS(5000));
+  }
+}
+
+void setup() {
+  delay(500);
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Shared Module");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN); // Hardware reset is recommended
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  xTaskCreate(workerTask, "uwb", 4096, nullptr, 2, nullptr);
+  xTaskCreate(rangingTask, "ranging", 4096, nullptr, 1, nullptr);
+  xTaskCreate(statusTask, "status", 4096, nullptr, 1, nullptr);
+}
+
+void loop() {
+  vTaskDelete(nullptr); // Everything runs in the tasks
+}
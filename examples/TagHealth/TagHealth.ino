@@ -0,0 +1,75 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_RangeStats.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+RYUW122_RangeStats stats;
+
+const RYUW122_Address TAGS[] = {"TAG1", "TAG2", "TAG3"};
+const uint8_t TAG_COUNT = sizeof(TAGS) / sizeof(TAGS[0]);
+
+uint8_t currentTag = 0;
+bool polling = false;
+unsigned long lastReport = 0;
+
+void setup() {
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Tag health");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN);
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+}
+
+void loop() {
+  // Poll the tags round robin
+  if (!polling) {
+    polling = uwb.sendMessageAsync(TAGS[currentTag], "R");
+    if (!polling) currentTag = (currentTag + 1) % TAG_COUNT;
+  } else {
+    RYUW122_MessageInfo info;
+    RYUW122_MessageState state = uwb.receiveMessageAsyncAnchor(info);
+    if (state != MESSAGE_WAITING) {
+      stats.report(TAGS[currentTag], state, info, millis()); // Constant time, nothing is stored per sample
+      polling = false;
+      currentTag = (currentTag + 1) % TAG_COUNT;
+    }
+  }
+
+  if (millis() - lastReport >= 10000) {
+    lastReport = millis();
+
+    RYUW122_TagStats tag;
+    for (size_t cursor = 0; stats.next(cursor, tag, millis());) {
+      char address[9];
+      tag.address.toString(address);
+      Serial.print(address);
+      Serial.print(": success ");
+      Serial.print(tag.successRatio * 100.0f);
+      Serial.print(" %, timeouts ");
+      Serial.print(tag.timeoutRatio * 100.0f);
+      Serial.print(" %, distance ");
+      Serial.print(tag.distanceMean);
+      Serial.print(" cm (sd ");
+      Serial.print(sqrt(tag.distanceVariance));
+      Serial.print("), interval ");
+      Serial.print(tag.interval);
+      Serial.print(" ms, jitter ");
+      Serial.print(tag.jitter);
+      Serial.print(" ms, last range ");
+      Serial.print(tag.timeSinceLastRange);
+      Serial.println(" ms ago");
+    }
+  }
+}
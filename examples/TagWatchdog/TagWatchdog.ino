@@ -0,0 +1,49 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_TagWatchdog.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+RYUW122_TagWatchdog watchdog(uwb);
+
+void setup() {
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Tag watchdog");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN); // Reset pin is required for the recovery
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  watchdog.setTrafficTimeout(3000);   // Probe the module when no anchor polled it for 3 s
+  watchdog.setFlashWriteBudget(500);  // Never spend more than 500 flash writes on recoveries
+  watchdog.setResponseMessage("HELLO"); // Sent now and restored after every recovery
+}
+
+void loop() {
+  RYUW122_MessageInfo info;
+
+  // Receives messages and probes / recovers the module when the traffic stops
+  if (watchdog.receive(info) == MESSAGE_RECEIVED) {
+    Serial.print("Payload: ");
+    Serial.println(info.payload);
+  }
+
+  static uint32_t recoveries = 0;
+  if (watchdog.getRecoveryCount() != recoveries) {
+    recoveries = watchdog.getRecoveryCount();
+    Serial.print("Recovery took ");
+    Serial.print(watchdog.getLastRecoveryTime());
+    Serial.print(" ms, flash writes used: ");
+    Serial.println(watchdog.getFlashWrites());
+  }
+}
@@ -0,0 +1,68 @@
+#include <RYUW122_UWB.h>
+#include <RYUW122_Payload.h>
+
+#define RYUW122_SERIAL_TX 8
+#define RYUW122_SERIAL_RX 15
+#define RYUW122_RESET_PIN 12
+
+#define TELEMETRY_TAG true // Flash one board with true (tag) and one with false (anchor)
+
+RYUW122_UWB uwb(Serial1); // You can also pass SoftwareSerial
+
+// Same schema on both sides: 6 characters instead of "3.71,22.5,54321,1"
+typedef RYUW122_PayloadCodec<RYUW122_FixedField<250, 430, 100>,  // Battery 2.50..4.30 V
+                             RYUW122_FixedField<-400, 850, 10>,  // Temperature -40.0..85.0 C
+                             RYUW122_UIntField<16>,              // Sequence number
+                             RYUW122_FlagField> Telemetry;       // Button pressed
+
+uint16_t sequence = 0;
+
+void setup() {
+  Serial.begin(115200); // Serial for debug output
+  Serial1.begin(115200, SERIAL_8N1, RYUW122_SERIAL_RX, RYUW122_SERIAL_TX); // Serial for RYUW122
+
+  Serial.println("RYUW122 example: Telemetry payload");
+
+  bool module = uwb.begin(RYUW122_RESET_PIN);
+  if (module) {
+    Serial.println("Module online!");
+  } else {
+    while (1) {
+      Serial.println("Module offline");
+      delay(500);
+    }
+  }
+
+  Serial.print("Encoded telemetry length: ");
+  Serial.println(Telemetry::Length);
+}
+
+void loop() {
+  if (TELEMETRY_TAG) {
+    // The next poll of the anchor receives the current values
+    char payload[Telemetry::BufferSize];
+    Telemetry::encode(payload, sizeof(payload), 3.71f, 22.5f, sequence++, digitalRead(0) == LOW);
+    uwb.setTagResponseMessage(payload);
+    delay(1000);
+  } else {
+    RYUW122_MessageInfo info;
+    if (uwb.sendMessage("DAVID123", "T") && uwb.receiveMessage(info)) {
+      float battery, temperature;
+      uint32_t seq;
+      bool pressed;
+      if (Telemetry::decode(info, battery, temperature, seq, pressed)) {
+        Serial.print("Distance: ");
+        Serial.print(info.distance);
+        Serial.print(" cm, battery: ");
+        Serial.print(battery);
+        Serial.print(" V, temperature: ");
+        Serial.print(temperature);
+        Serial.print(" C, sequence: ");
+        Serial.print(seq);
+        Serial.print(", pressed: ");
+        Serial.println(pressed);
+      }
+    }
+    delay(200);
+  }
+}
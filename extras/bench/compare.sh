@@ -0,0 +1,46 @@
+#!/bin/sh
+# Compares two ryuw122_bench outputs: compare.sh old.json new.json [threshold %]
+# Prints CPU time per operation (and the modelled cycle time where present) side by side and exits with 1
+# when a benchmark got slower by more than the threshold (default 10 %).
+
+set -e
+if [ $# -lt 2 ]; then
+    echo "usage: $0 old.json new.json [threshold %]" >&2
+    exit 2
+fi
+
+awk -v threshold="${3:-10}" '
+function field(line, key,    start, rest) {
+    start = index(line, "\"" key "\":")
+    if (start == 0) return ""
+    rest = substr(line, start + length(key) + 3)
+    sub(/^"/, "", rest)
+    sub(/[",}].*$/, "", rest)
+    return rest
+}
+{
+    id = field($0, "name") "@" field($0, "baud") "/" field($0, "profile")
+    if (FNR == NR) {
+        oldNs[id] = field($0, "ns_per_op")
+        oldModel[id] = field($0, "modelled_us_per_cycle")
+        next
+    }
+    if (!(id in oldNs)) { printf "%-40s %12s %12s %8s\n", id, "-", field($0, "ns_per_op"), "new"; next }
+
+    ns = field($0, "ns_per_op")
+    change = oldNs[id] > 0 ? (ns - oldNs[id]) * 100 / oldNs[id] : 0
+    flag = change > threshold ? "  SLOWER" : ""
+    if (change > threshold) slower++
+    printf "%-40s %12.1f %12.1f %+7.1f%%%s\n", id, oldNs[id], ns, change, flag
+
+    model = field($0, "modelled_us_per_cycle")
+    if (model != "" && oldModel[id] != "") {
+        change = (model - oldModel[id]) * 100 / oldModel[id]
+        flag = change > 0.5 ? "  SLOWER" : ""
+        if (change > 0.5) slower++
+        printf "%-40s %12.1f %12.1f %+7.1f%%%s\n", "  modelled us/cycle", oldModel[id], model, change, flag
+    }
+}
+BEGIN { printf "%-40s %12s %12s %8s\n", "benchmark", "old ns/op", "new ns/op", "change" }
+END { exit slower > 0 ? 1 : 0 }
+' "$1" "$2"
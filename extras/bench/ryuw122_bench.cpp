@@ -0,0 +1,332 @@
+/*
+  ryuw122_bench.cpp - Host benchmark of the RYUW122_UWB ranging pipeline.
+  Released into the public domain.
+
+  Usage: ryuw122_bench [milliseconds per benchmark] [ranging time us]
+  The library runs against a scripted in-memory Stream on a virtual clock, nothing waits for real time.
+  Stage benchmarks report the host CPU time of command encoding, response scanning and parsing. Cycle
+  benchmarks drive sendMessageAsync() -> receiveMessageAsyncAnchor() against an emulated module at
+  9600 / 57600 / 115200 baud (10 bits per byte) and report the modelled cycle time besides the CPU time.
+  Every result is one JSON object per line, see compare.sh.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "RYUW122_UWB.h"
+
+namespace
+{
+// Module time per range besides the UART bytes: about 16 Hz at 115200 baud (README) minus ~6 ms of bytes
+const uint32_t DefaultRangingTime = 56000; // [us]
+const uint32_t CommandTime = 500;          // Module time from the end of a command to its OK [us]
+const uint32_t IdlePollStep = 50;          // Virtual time that passes when the library polls an empty UART [us]
+const int Repeats = 5;                     // Batches per stage benchmark, the median is reported
+
+class VirtualClock : public HostClock
+{
+public:
+    unsigned long micros() override { return (unsigned long)now; }
+    void delayMicroseconds(unsigned long us) override { now += us; }
+    void yield() override { now += 1; }
+
+    uint64_t now = 0;
+};
+
+VirtualClock virtualClock;
+
+/*
+  Stream with modelled byte timing. Bytes queued for the library become available at their arrival time;
+  when the library polls and the next byte is still on the wire, the clock jumps to its arrival, as a
+  polling loop would wait for it. A responder sees every complete command line once its last byte was
+  transmitted. byteTime 0 makes everything instant (stage benchmarks).
+*/
+class ScriptedStream : public Stream
+{
+public:
+    typedef std::function<void(const std::string &line, uint64_t time)> Responder;
+
+    uint32_t byteTime = 0; // [us]
+    Responder responder;
+    uint64_t bytesWritten = 0;
+    uint64_t bytesRead = 0;
+
+    size_t write(uint8_t c) override
+    {
+        bytesWritten++;
+        txFree = std::max(txFree, virtualClock.now) + byteTime;
+        if (!responder) return 1;
+
+        txLine += (char)c;
+        if (c == '\n')
+        {
+            std::string line;
+            line.swap(txLine);
+            responder(line, txFree);
+        }
+        return 1;
+    }
+
+    // Queues a module line whose first byte starts no earlier than time
+    void send(const std::string &line, uint64_t time)
+    {
+        uint64_t arrival = std::max(time, rxFree);
+        for (char c : line)
+        {
+            arrival += byteTime;
+            rx.push_back(Byte{c, arrival});
+        }
+        rxFree = arrival;
+    }
+
+    void preload(const char *text)
+    {
+        for (const char *c = text; *c; ++c) rx.push_back(Byte{*c, 0});
+    }
+
+    int available() override
+    {
+        if (rx.empty())
+        {
+            virtualClock.now += IdlePollStep;
+            return 0;
+        }
+        if (rx.front().arrival > virtualClock.now) virtualClock.now = rx.front().arrival;
+
+        int count = 0;
+        for (const Byte &byte : rx)
+        {
+            if (byte.arrival > virtualClock.now) break;
+            count++;
+        }
+        return count;
+    }
+
+    int read() override
+    {
+        if (rx.empty() || rx.front().arrival > virtualClock.now) return -1;
+        char c = rx.front().c;
+        rx.pop_front();
+        bytesRead++;
+        return (uint8_t)c;
+    }
+
+    int peek() override
+    {
+        return rx.empty() || rx.front().arrival > virtualClock.now ? -1 : (uint8_t)rx.front().c;
+    }
+
+    void reset()
+    {
+        rx.clear();
+        txLine.clear();
+        txFree = rxFree = virtualClock.now;
+        bytesWritten = bytesRead = 0;
+    }
+
+private:
+    struct Byte
+    {
+        char c;
+        uint64_t arrival;
+    };
+
+    std::deque<Byte> rx;
+    std::string txLine;
+    uint64_t txFree = 0;
+    uint64_t rxFree = 0;
+};
+
+const char *profileName()
+{
+#if RYUW122_PROFILE_TINY && RYUW122_ANCHOR_ONLY
+    return "tiny-anchor";
+#elif RYUW122_PROFILE_TINY && RYUW122_TAG_ONLY
+    return "tiny-tag";
+#elif RYUW122_PROFILE_TINY
+    return "tiny";
+#elif RYUW122_ANCHOR_ONLY
+    return "anchor-only";
+#elif RYUW122_TAG_ONLY
+    return "tag-only";
+#else
+    return "default";
+#endif
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs batches of body() for about budget milliseconds, prints the median and best time per call
+void runStage(const char *name, uint32_t budget, const std::function<void()> &body)
+{
+    // Calibrate the batch size to a fifth of the budget
+    uint64_t iterations = 1;
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) body();
+        if (elapsedNs(start) >= budget * 1e6 / Repeats / 4 || iterations >= (1ULL << 30)) break;
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int r = 0; r < Repeats; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) body();
+        samples.push_back(elapsedNs(start) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    printf("{\"name\":\"%s\",\"profile\":\"%s\",\"baud\":0,\"iterations\":%llu,\"ns_per_op\":%.1f,\"ns_per_op_min\":%.1f}\n",
+           name, profileName(), (unsigned long long)(iterations * Repeats), samples[Repeats / 2], samples[0]);
+    fflush(stdout);
+}
+}
+
+// Friend of RYUW122_UWB, reaches the stages that the public API only runs together
+class RYUW122_UWBBenchmark
+{
+public:
+    static void stages(uint32_t budget)
+    {
+        ScriptedStream stream;
+        RYUW122_UWB uwb(stream);
+
+        runStage("encode_command", budget, [&]()
+        {
+            uwb.sendCommandWithValue(F("AT+TAGD="), "1000,2000");
+        });
+
+#if RYUW122_HAS_ANCHOR
+        RYUW122_Address tag("DAVID123");
+        runStage("encode_anchor_send", budget, [&]()
+        {
+            uwb.sendMessage(tag, "TELE", 0, false, true); // Builds the poll and writes it without waiting
+        });
+#endif
+
+        runStage("scan_ok", budget, [&]()
+        {
+            stream.preload("OK\r\n");
+            uwb.readResponse(nullptr, 100);
+        });
+
+        runStage("scan_error", budget, [&]()
+        {
+            stream.preload("+ERR=2\r\n");
+            uwb.readResponse(nullptr, 100);
+        });
+
+#if RYUW122_HAS_TAG
+        runStage("scan_ok_with_message", budget, [&]()
+        {
+            stream.preload("+TAG_RCV=4,TELE\r\nOK\r\n"); // Message is moved to the receive queue
+            uwb.readResponse(nullptr, 100);
+            uwb.clearReceiveQueue();
+        });
+#endif
+
+#if RYUW122_HAS_ANCHOR
+        static const char AnchorLine[] = "+ANCHOR_RCV=DAVID123,4,TELE,123 cm\r\n";
+        runStage("parse_anchor", budget, [&]()
+        {
+            char line[sizeof(AnchorLine)];
+            memcpy(line, AnchorLine, sizeof(line)); // Parsing splits the line in place
+            RYUW122_MessageInfo info;
+            uwb.parseAnchorResponse(line, info);
+        });
+#endif
+
+#if RYUW122_HAS_TAG
+        static const char TagLine[] = "+TAG_RCV=4,TELE\r\n";
+        runStage("parse_tag", budget, [&]()
+        {
+            char line[sizeof(TagLine)];
+            memcpy(line, TagLine, sizeof(line));
+            RYUW122_MessageInfo info;
+            uwb.parseTagResponse(line, info);
+        });
+#endif
+    }
+
+#if RYUW122_HAS_ANCHOR
+    // Full poll cycles against an emulated anchor module at one baud rate
+    static void cycles(uint32_t baud, uint32_t budget, uint32_t rangingTime)
+    {
+        ScriptedStream stream;
+        stream.byteTime = (10 * 1000000UL + baud / 2) / baud;
+        stream.responder = [&](const std::string &line, uint64_t time)
+        {
+            static const char Send[] = "AT+ANCHOR_SEND=";
+            if (line.compare(0, sizeof(Send) - 1, Send) != 0)
+            {
+                stream.send("OK\r\n", time + CommandTime);
+                return;
+            }
+            std::string address = line.substr(sizeof(Send) - 1, 8);
+            stream.send("OK\r\n", time + CommandTime);
+            stream.send("+ANCHOR_RCV=" + address + ",4,TELE,123 cm\r\n", time + CommandTime + rangingTime);
+        };
+
+        RYUW122_UWB uwb(stream);
+        RYUW122_Address tag("DAVID123");
+        RYUW122_MessageInfo info;
+
+        uint64_t cycles = 0;
+        uint64_t failures = 0;
+        uint64_t virtualStart = virtualClock.now;
+        auto start = std::chrono::steady_clock::now();
+        while (elapsedNs(start) < budget * 1e6)
+        {
+            if (!uwb.sendMessageAsync(tag, "TELE"))
+            {
+                failures++;
+                continue;
+            }
+            RYUW122_MessageState state;
+            while ((state = uwb.receiveMessageAsyncAnchor(info)) == MESSAGE_WAITING) {}
+            if (state != MESSAGE_RECEIVED) failures++;
+            cycles++;
+        }
+        double cpu = elapsedNs(start);
+        double modelled = (double)(virtualClock.now - virtualStart) / (cycles ? cycles : 1);
+
+        printf("{\"name\":\"range_cycle\",\"profile\":\"%s\",\"baud\":%u,\"iterations\":%llu,\"ns_per_op\":%.1f,"
+               "\"modelled_us_per_cycle\":%.1f,\"modelled_rate_hz\":%.2f,\"bytes_tx_per_cycle\":%.1f,\"bytes_rx_per_cycle\":%.1f,"
+               "\"failures\":%llu}\n",
+               profileName(), baud, (unsigned long long)cycles, cpu / (cycles ? cycles : 1),
+               modelled, modelled > 0 ? 1e6 / modelled : 0.0,
+               (double)stream.bytesWritten / (cycles ? cycles : 1), (double)stream.bytesRead / (cycles ? cycles : 1),
+               (unsigned long long)failures);
+        fflush(stdout);
+    }
+#endif
+};
+
+int main(int argc, char **argv)
+{
+    uint32_t budget = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 500;
+    uint32_t rangingTime = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : DefaultRangingTime;
+
+    hostSetClock(&virtualClock);
+
+    RYUW122_UWBBenchmark::stages(budget);
+#if RYUW122_HAS_ANCHOR
+    static const uint32_t BaudRates[] = {9600, 57600, 115200};
+    for (uint32_t baud : BaudRates)
+        RYUW122_UWBBenchmark::cycles(baud, budget, rangingTime);
+#endif
+
+    hostSetClock(nullptr);
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+  RYUW122_ExportDecoder.h - Host decoder for binary frames written by RYUW122_Exporter.
+  Released into the public domain.
+
+  Header-only, needs no library sources. Bytes can be fed in any chunking; the decoder looks for the
+  frame sync, checks the CRC and skips damaged frames, so a lost byte costs only the frames involved.
+  Samples of tags whose address was not seen yet (reader attached mid-stream, address sent in a
+  damaged frame) are counted in unknownSamples until the exporter starts its next dictionary epoch.
+*/
+
+#ifndef RYUW122_EXPORT_DECODER_H
+#define RYUW122_EXPORT_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+struct RYUW122_ExportSample
+{
+    uint32_t time;            // Device millis() when the range was added [ms]
+    char address[9];          // 8 space padded characters + null terminator
+    uint16_t distance;        // [cm]
+    uint8_t payloadLength;    // 0 unless the exporter includes payloads
+    char payload[13];
+};
+
+class RYUW122_ExportDecoder
+{
+public:
+    static constexpr uint8_t FrameVersion = 1;
+    static constexpr uint8_t MaxTags = 64;
+    static constexpr size_t MaxBodyLength = 4096; // Larger lengths are corrupted headers
+
+    // Calls sink(const RYUW122_ExportSample &) for every sample of every valid frame
+    template <typename Sink>
+    void feed(const uint8_t *data, size_t len, Sink sink)
+    {
+        pending.insert(pending.end(), data, data + len);
+
+        size_t position = 0;
+        for (;;)
+        {
+            while (position < pending.size() && pending[position] != 0xA5) position++; // Look for the sync
+            if (pending.size() - position < 5) break;
+            if (pending[position + 1] != 0x5A || (pending[position + 2] >> 4) != FrameVersion)
+            {
+                position++;
+                skippedBytes++;
+                continue;
+            }
+
+            size_t bodyLength = pending[position + 3] | (size_t)pending[position + 4] << 8;
+            if (bodyLength < 6 || bodyLength > MaxBodyLength)
+            {
+                position++;
+                skippedBytes++;
+                continue;
+            }
+
+            size_t frameLength = 5 + bodyLength + 2;
+            if (pending.size() - position < frameLength) break; // Wait for the rest of the frame
+
+            const uint8_t *frame = &pending[position];
+            uint16_t crc = frame[5 + bodyLength] | (uint16_t)frame[5 + bodyLength + 1] << 8;
+            if (crc16(frame + 2, 3 + bodyLength) != crc || !decodeBody(frame[2], frame + 5, bodyLength, sink))
+            {
+                crcErrors++;
+                position++;
+                skippedBytes++;
+                continue;
+            }
+
+            frames++;
+            position += frameLength;
+        }
+
+        pending.erase(pending.begin(), pending.begin() + position);
+    }
+
+    uint64_t frames = 0;
+    uint64_t samples = 0;
+    uint64_t crcErrors = 0;      // Frames dropped for a CRC or layout error
+    uint64_t skippedBytes = 0;   // Bytes skipped while looking for a frame
+    uint64_t unknownSamples = 0; // Samples of valid frames whose tag address is not known
+
+private:
+    std::vector<uint8_t> pending;
+    char dictionary[MaxTags][8];
+    bool defined[MaxTags] = {};
+    uint8_t epoch = 0;
+    bool hasEpoch = false;
+
+    static uint16_t crc16(const uint8_t *data, size_t len)
+    {
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < len; ++i)
+        {
+            crc ^= (uint16_t)data[i] << 8;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = crc & 0x8000 ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+        return crc;
+    }
+
+    static bool varint(const uint8_t *&p, const uint8_t *end, uint32_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            if (p >= end) return false;
+            uint8_t byte = *p++;
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    template <typename Sink>
+    bool decodeBody(uint8_t versionFlags, const uint8_t *body, size_t len, Sink &sink)
+    {
+        const uint8_t *p = body;
+        const uint8_t *end = body + len;
+        bool payloads = versionFlags & 0x01;
+
+        uint32_t time = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        uint8_t frameEpoch = p[4];
+        uint8_t count = p[5];
+        p += 6;
+
+        // Decode the whole frame first, a damaged frame changes nothing and delivers nothing
+        std::vector<RYUW122_ExportSample> decoded;
+        std::vector<uint8_t> indices;
+        bool addressed[MaxTags] = {}; // Address sent in this frame
+        char addresses[MaxTags][8];
+        int32_t distances[MaxTags];   // Last distance per index in this frame, -1 before the first one
+        for (int32_t &distance : distances) distance = -1;
+        uint64_t unknown = 0;
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            if (p >= end) return false;
+            uint8_t header = *p++;
+            uint8_t index = header & 0x3F;
+
+            RYUW122_ExportSample sample;
+            memset(&sample, 0, sizeof(sample));
+            if (header & 0x40)
+            {
+                if (!(header & 0x80) || end - p < 8) return false;
+                memcpy(addresses[index], p, 8);
+                addressed[index] = true;
+                p += 8;
+            }
+
+            uint32_t dt, value;
+            if (!varint(p, end, dt) || !varint(p, end, value)) return false;
+            int32_t distance;
+            if (header & 0x80)
+            {
+                distance = (int32_t)value;
+            }
+            else
+            {
+                if (distances[index] < 0) return false; // A delta needs an absolute distance earlier in the frame
+                distance = distances[index] + ((int32_t)(value >> 1) ^ -(int32_t)(value & 1));
+            }
+            if (distance < 0 || distance > 0xFFFF) return false;
+            distances[index] = distance;
+            sample.distance = (uint16_t)distance;
+
+            if (payloads)
+            {
+                if (p >= end) return false;
+                sample.payloadLength = *p++;
+                if (sample.payloadLength > 12 || end - p < sample.payloadLength) return false;
+                memcpy(sample.payload, p, sample.payloadLength);
+                p += sample.payloadLength;
+            }
+
+            time += dt;
+            sample.time = time;
+            decoded.push_back(sample);
+            indices.push_back(index); // Address is resolved once the frame is known to be valid
+        }
+        if (p != end) return false;
+
+        if (!hasEpoch || frameEpoch != epoch) memset(defined, 0, sizeof(defined)); // Indices of another epoch mean other tags
+        epoch = frameEpoch;
+        hasEpoch = true;
+        for (uint8_t index = 0; index < MaxTags; ++index)
+        {
+            if (!addressed[index]) continue;
+            memcpy(dictionary[index], addresses[index], 8);
+            defined[index] = true;
+        }
+
+        for (size_t i = 0; i < decoded.size(); ++i)
+        {
+            RYUW122_ExportSample &sample = decoded[i];
+            uint8_t index = indices[i];
+            if (!defined[index])
+            {
+                unknown++;
+                continue;
+            }
+            memcpy(sample.address, dictionary[index], 8);
+            sample.address[8] = '\0';
+            sink(sample);
+            samples++;
+        }
+        unknownSamples += unknown;
+        return true;
+    }
+};
+
+#endif // RYUW122_EXPORT_DECODER_H
@@ -0,0 +1,92 @@
+/*
+  ryuw122_export_decode.cpp - Converts RYUW122_Exporter binary frames into InfluxDB line protocol.
+  Released into the public domain.
+
+  Usage: ryuw122_export_decode [--host-time] [--measurement name] [input]
+  Reads a capture file, a tty (configure it first, e.g. stty -F /dev/ttyACM0 921600 raw) or stdin and
+  prints one line per range. Timestamps are device milliseconds; with --host-time they are nanoseconds
+  since the epoch, anchored to the host clock when the first frame arrives. Statistics go to stderr.
+*/
+
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "RYUW122_ExportDecoder.h"
+
+int main(int argc, char **argv)
+{
+    bool hostTime = false;
+    const char *measurement = "ryuw122";
+    const char *path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--host-time") == 0) hostTime = true;
+        else if (strcmp(argv[i], "--measurement") == 0 && i + 1 < argc) measurement = argv[++i];
+        else path = argv[i];
+    }
+
+    int fd = path ? open(path, O_RDONLY | O_NOCTTY) : STDIN_FILENO;
+    if (fd < 0)
+    {
+        perror(path);
+        return 1;
+    }
+
+    RYUW122_ExportDecoder decoder;
+    bool anchored = false;
+    int64_t offsetNs = 0;
+
+    auto print = [&](const RYUW122_ExportSample &sample)
+    {
+        if (hostTime && !anchored)
+        {
+            int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            offsetNs = now - (int64_t)sample.time * 1000000;
+            anchored = true;
+        }
+
+        size_t addressLen = 8;
+        while (addressLen > 0 && sample.address[addressLen - 1] == ' ') addressLen--;
+
+        printf("%s,tag=", measurement);
+        for (size_t i = 0; i < addressLen; ++i)
+        {
+            char c = sample.address[i];
+            if (c == ',' || c == ' ' || c == '=') putchar('\\');
+            putchar(c);
+        }
+        printf(" distance=%ui", sample.distance);
+        if (sample.payloadLength)
+        {
+            printf(",payload=\"");
+            for (uint8_t i = 0; i < sample.payloadLength; ++i)
+            {
+                char c = sample.payload[i];
+                if (c == '"' || c == '\\') putchar('\\');
+                putchar(c);
+            }
+            putchar('"');
+        }
+        if (hostTime) printf(" %lld\n", (long long)(offsetNs + (int64_t)sample.time * 1000000));
+        else printf(" %u\n", sample.time);
+    };
+
+    uint8_t chunk[4096];
+    for (;;)
+    {
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) break;
+        decoder.feed(chunk, (size_t)n, print);
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "frames %llu, samples %llu, damaged frames %llu, skipped bytes %llu, samples of unknown tags %llu\n",
+            (unsigned long long)decoder.frames, (unsigned long long)decoder.samples,
+            (unsigned long long)decoder.crcErrors, (unsigned long long)decoder.skippedBytes,
+            (unsigned long long)decoder.unknownSamples);
+    return 0;
+}
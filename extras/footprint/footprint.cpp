@@ -0,0 +1,16 @@
+/*
+  footprint.cpp - Prints the RAM taken by the library objects for the profile it is compiled with.
+  Released into the public domain.
+
+  Built and run by footprint.sh once per profile.
+*/
+
+#include <stdio.h>
+
+#include "RYUW122_UWB.h"
+
+int main()
+{
+    printf("%zu %zu %d %d\n", sizeof(RYUW122_UWB), sizeof(RYUW122_MessageInfo), RYUW122_MAX_PAYLOAD, RYUW122_RECEIVE_QUEUE_SIZE);
+    return 0;
+}
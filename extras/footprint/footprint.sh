@@ -0,0 +1,47 @@
+#!/bin/sh
+# Footprint report of RYUW122_UWB for every build profile, run from the repository root.
+#
+# Host columns (always available): the library core (src/RYUW122_UWB.cpp) is compiled with -Os for the
+# host. "code" is .text, "flash strings" is what PROGMEM keeps in flash, "RAM constants" are strings and tables an
+# AVR build would copy into RAM, "object" is sizeof(RYUW122_UWB) and "message" sizeof(RYUW122_MessageInfo).
+# Host code size is only comparable between profiles, not with AVR.
+#
+# AVR columns: when arduino-cli with the arduino:avr core is installed, examples/SimpleTag is built for
+# an Arduino Nano with the same flags and the flash / RAM totals reported by the build are printed.
+
+set -e
+CXX=${CXX:-g++}
+OUT=${TMPDIR:-/tmp}/ryuw122_footprint
+mkdir -p "$OUT"
+
+profiles="default:
+tiny:-DRYUW122_PROFILE_TINY=1
+anchor-only:-DRYUW122_ANCHOR_ONLY=1
+tag-only:-DRYUW122_TAG_ONLY=1
+tiny-anchor:-DRYUW122_PROFILE_TINY=1 -DRYUW122_ANCHOR_ONLY=1
+tiny-tag:-DRYUW122_PROFILE_TINY=1 -DRYUW122_TAG_ONLY=1"
+
+printf "%-12s %8s %14s %14s %8s %8s" profile code "flash strings" "RAM constants" object message
+if command -v arduino-cli >/dev/null 2>&1; then printf " %10s %8s" "AVR flash" "AVR RAM"; fi
+printf "\n"
+
+echo "$profiles" | while IFS=: read -r name flags; do
+    $CXX -std=gnu++11 -Os -fno-exceptions $flags -Iextras/host -Isrc -c src/RYUW122_UWB.cpp -o "$OUT/uwb.o"
+    $CXX -std=gnu++11 $flags -Iextras/host -Isrc extras/footprint/footprint.cpp extras/host/Arduino.cpp -o "$OUT/footprint"
+
+    sizes=$(size -A "$OUT/uwb.o" | awk '
+        $1 ~ /^\.text/ { code += $2 }
+        $1 ~ /^\.progmem/ { flash += $2 }
+        $1 ~ /^\.rodata/ { ram += $2 }
+        END { printf "%d %d %d", code, flash, ram }')
+    set -- $sizes $("$OUT/footprint")
+    printf "%-12s %8s %14s %14s %8s %8s" "$name" "$1" "$2" "$3" "$4" "$5"
+
+    if command -v arduino-cli >/dev/null 2>&1; then
+        avr=$(arduino-cli compile --fqbn arduino:avr:nano --library . --build-property "compiler.cpp.extra_flags=$flags" \
+            examples/SimpleTag 2>/dev/null | awk '/Sketch uses/ { flash = $3 } /Global variables use/ { ram = $4 } END { printf "%s %s", flash, ram }')
+        set -- $avr
+        printf " %10s %8s" "$1" "$2"
+    fi
+    printf "\n"
+done
@@ -0,0 +1,112 @@
+/*
+  Arduino.cpp - Minimal Arduino core for building RYUW122_UWB on Linux hosts.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+class SystemClock : public HostClock
+{
+public:
+    unsigned long micros() override
+    {
+        using namespace std::chrono;
+        return static_cast<unsigned long>(duration_cast<microseconds>(steady_clock::now() - start).count());
+    }
+
+    void delayMicroseconds(unsigned long us) override
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+
+    void yield() override
+    {
+        std::this_thread::yield();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+SystemClock systemClock;
+HostClock *activeClock = &systemClock;
+HostDigitalWrite digitalWriteCallback = nullptr;
+}
+
+void hostSetClock(HostClock *clock)
+{
+    activeClock = clock ? clock : &systemClock;
+}
+
+void hostSetDigitalWrite(HostDigitalWrite callback)
+{
+    digitalWriteCallback = callback;
+}
+
+unsigned long millis()
+{
+    return activeClock->micros() / 1000;
+}
+
+unsigned long micros()
+{
+    return activeClock->micros();
+}
+
+void delay(unsigned long ms)
+{
+    activeClock->delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned long us)
+{
+    activeClock->delayMicroseconds(us);
+}
+
+void yield()
+{
+    activeClock->yield();
+}
+
+void pinMode(int, int)
+{
+}
+
+void digitalWrite(int pin, int value)
+{
+    if (digitalWriteCallback) digitalWriteCallback(pin, value);
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    while (written < size && write(buffer[written]))
+        written++;
+    return written;
+}
+
+size_t Print::print(long value)
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%ld", value);
+    return write(buffer);
+}
+
+size_t Print::print(unsigned long value)
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%lu", value);
+    return write(buffer);
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer);
+}
@@ -0,0 +1,96 @@
+/*
+  Arduino.h - Minimal Arduino core for building RYUW122_UWB on Linux hosts (gateways, tools, benchmarks).
+  Released into the public domain.
+
+  Only what the library uses is provided: Print / Stream, timing and the GPIO calls used by reset().
+  The clock can be replaced (see HostClock) so benchmarks and emulators can run on virtual time.
+*/
+
+#ifndef RYUW122_HOST_ARDUINO_H
+#define RYUW122_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define OUTPUT 1
+#define INPUT 0
+#define LOW 0
+#define HIGH 1
+
+// Flash strings live in their own section, so a host build shows what an AVR build keeps in RAM
+// (extras/footprint); reading them needs no special access on the host
+#define PROGMEM __attribute__((section(".progmem.data")))
+#define PSTR(s) (__extension__({ static const char __pstr[] PROGMEM = (s); &__pstr[0]; }))
+#define PGM_P const char *
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+
+#define strstr_P strstr
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+#define snprintf_P snprintf
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t *>(address))
+
+// Time source used by millis(), micros() and delay(); the default one is the monotonic system clock
+class HostClock
+{
+public:
+    virtual ~HostClock() {}
+    virtual unsigned long micros() = 0;
+    virtual void delayMicroseconds(unsigned long us) = 0;
+    virtual void yield() {}
+};
+
+void hostSetClock(HostClock *clock); // nullptr restores the system clock
+
+// GPIO writes are forwarded here when set, e.g. to toggle a reset line through a GPIO chip
+typedef void (*HostDigitalWrite)(int pin, int value);
+void hostSetDigitalWrite(HostDigitalWrite callback);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned long us);
+void yield();
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+    size_t write(const char *str) { return str ? write(str, strlen(str)) : 0; }
+    virtual void flush() {}
+
+    size_t print(const char *str) { return write(str); }
+    size_t print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int value) { return print(static_cast<long>(value)); }
+    size_t print(unsigned int value) { return print(static_cast<unsigned long>(value)); }
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T value) { return print(value) + println(); }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+#endif // RYUW122_HOST_ARDUINO_H
@@ -0,0 +1,126 @@
+/*
+  HostSerial.cpp - Stream over a POSIX serial port (or pty) for RYUW122_UWB on Linux hosts.
+  Released into the public domain.
+*/
+
+#include "HostSerial.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+speed_t toSpeed(unsigned long baudRate)
+{
+    switch (baudRate)
+    {
+    case 9600: return B9600;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    default: return B0;
+    }
+}
+}
+
+HostSerial::~HostSerial()
+{
+    end();
+}
+
+bool HostSerial::begin(const char *path, unsigned long baudRate)
+{
+    end();
+
+    speed_t speed = toSpeed(baudRate);
+    if (speed == B0) return false;
+
+    fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) return false;
+
+    termios options;
+    if (tcgetattr(fd, &options) == 0)
+    {
+        cfmakeraw(&options);
+        cfsetispeed(&options, speed);
+        cfsetospeed(&options, speed);
+        options.c_cflag |= CLOCAL | CREAD;
+        options.c_cflag &= ~(CSTOPB | PARENB);
+        tcsetattr(fd, TCSANOW, &options);
+    }
+    tcflush(fd, TCIOFLUSH);
+
+    rxHead = 0;
+    rxCount = 0;
+    return true;
+}
+
+void HostSerial::end()
+{
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+void HostSerial::fill()
+{
+    if (fd < 0 || rxCount == sizeof(rxBuffer)) return;
+
+    if (rxHead > 0)
+    {
+        memmove(rxBuffer, rxBuffer + rxHead, rxCount);
+        rxHead = 0;
+    }
+
+    ssize_t n = ::read(fd, rxBuffer + rxCount, sizeof(rxBuffer) - rxCount);
+    if (n > 0) rxCount += static_cast<size_t>(n);
+}
+
+int HostSerial::available()
+{
+    fill();
+    return static_cast<int>(rxCount);
+}
+
+int HostSerial::read()
+{
+    if (rxCount == 0) fill();
+    if (rxCount == 0) return -1;
+
+    int c = rxBuffer[rxHead++];
+    rxCount--;
+    return c;
+}
+
+int HostSerial::peek()
+{
+    if (rxCount == 0) fill();
+    return rxCount ? rxBuffer[rxHead] : -1;
+}
+
+size_t HostSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size)
+{
+    if (fd < 0) return 0;
+
+    size_t written = 0;
+    while (written < size)
+    {
+        ssize_t n = ::write(fd, buffer + written, size - written);
+        if (n > 0)
+        {
+            written += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno != EAGAIN && errno != EINTR) break;
+
+        pollfd descriptor = {fd, POLLOUT, 0};
+        ::poll(&descriptor, 1, 100);
+    }
+    return written;
+}
@@ -0,0 +1,39 @@
+/*
+  HostSerial.h - Stream over a POSIX serial port (or pty) for RYUW122_UWB on Linux hosts.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_HOST_SERIAL_H
+#define RYUW122_HOST_SERIAL_H
+
+#include "Arduino.h"
+
+class HostSerial : public Stream
+{
+public:
+    HostSerial() {}
+    ~HostSerial() override;
+    HostSerial(const HostSerial &) = delete;
+    HostSerial &operator=(const HostSerial &) = delete;
+
+    bool begin(const char *path, unsigned long baudRate = 115200); // Raw 8N1, non-blocking
+    void end();
+    bool isOpen() const { return fd >= 0; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+private:
+    int fd = -1;
+    uint8_t rxBuffer[256];
+    size_t rxHead = 0;
+    size_t rxCount = 0;
+
+    void fill();
+};
+
+#endif // RYUW122_HOST_SERIAL_H
@@ -0,0 +1,232 @@
+/*
+  ryuw122_emulator.cpp - Emulates RYUW122 modules on pseudo terminals for testing host tools.
+  Released into the public domain.
+
+  Usage: ryuw122_emulator <count> [flash write time ms] [uid prefix]
+  Creates <count> pty pairs and prints "<slave path> <UID>" for each, then answers AT commands until
+  terminated. Setters are answered after the flash write time, like the real module that is busy
+  while it stores a parameter. All parameters start at the factory defaults.
+*/
+
+#include <chrono>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+struct Module
+{
+    int master = -1;
+    int slave = -1;             // Kept open, so the pty does not hang up between tool runs
+    std::string path;
+    std::string uid;
+    std::string input;
+    std::string pending;        // Response delayed until the flash write is finished
+    long long busyUntil = 0;
+
+    std::string mode = "0";
+    std::string baudRate = "115200";
+    std::string channel = "5";
+    std::string bandwidth = "0";
+    std::string networkID = "REYAX123";
+    std::string address = "REYAX123";
+    std::string password = "FABC0002EEDCAA90FABC0002EEDCAA90";
+    std::string tagParameters = "0,0";
+    std::string calibration = "0";
+    unsigned long flashWrites = 0;
+};
+
+volatile sig_atomic_t running = 1;
+
+void stop(int)
+{
+    running = 0;
+}
+
+long long nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool openPty(Module &module)
+{
+    module.master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (module.master < 0 || grantpt(module.master) != 0 || unlockpt(module.master) != 0) return false;
+
+    const char *name = ptsname(module.master);
+    if (!name) return false;
+    module.path = name;
+
+    module.slave = open(name, O_RDWR | O_NOCTTY);
+    if (module.slave < 0) return false;
+
+    termios tty;
+    tcgetattr(module.slave, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(module.slave, TCSANOW, &tty);
+
+    fcntl(module.master, F_SETFL, fcntl(module.master, F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+bool isDigits(const std::string &value, bool allowSign = false)
+{
+    if (value.empty()) return false;
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        if (allowSign && i == 0 && value[i] == '-') continue;
+        if (value[i] < '0' || value[i] > '9') return false;
+    }
+    return true;
+}
+
+// Returns the response, empty for an unknown command (answered with +ERR)
+std::string execute(Module &module, const std::string &line, bool &flashWrite)
+{
+    flashWrite = false;
+    if (line == "AT") return "+OK\r\n";
+    if (line == "AT+RESET") return "+RESET\r\n+READY\r\n";
+    if (line == "AT+UID?") return "+UID=" + module.uid + "\r\n";
+    if (line == "AT+VER?") return "+VER=EMU1.0\r\n";
+
+    struct Parameter
+    {
+        const char *name;
+        std::string *value;
+    } parameters[] = {
+        {"MODE", &module.mode}, {"IPR", &module.baudRate}, {"CHANNEL", &module.channel},
+        {"BANDWIDTH", &module.bandwidth}, {"NETWORKID", &module.networkID}, {"ADDRESS", &module.address},
+        {"CPIN", &module.password}, {"TAGD", &module.tagParameters}, {"CAL", &module.calibration}};
+
+    for (Parameter &parameter : parameters)
+    {
+        std::string command = std::string("AT+") + parameter.name;
+        if (line.compare(0, command.size(), command) != 0) continue;
+
+        std::string rest = line.substr(command.size());
+        if (rest == "?") return std::string("+") + parameter.name + "=" + *parameter.value + "\r\n";
+        if (rest.empty() || rest[0] != '=') return "";
+
+        std::string value = rest.substr(1);
+        bool valid = false;
+        if (command == "AT+MODE") valid = value == "0" || value == "1" || value == "2";
+        else if (command == "AT+IPR") valid = value == "9600" || value == "57600" || value == "115200";
+        else if (command == "AT+CHANNEL") valid = value == "5" || value == "9";
+        else if (command == "AT+BANDWIDTH") valid = value == "0" || value == "1";
+        else if (command == "AT+NETWORKID" || command == "AT+ADDRESS") valid = value.size() == 8;
+        else if (command == "AT+CPIN") valid = value.size() == 32;
+        else if (command == "AT+TAGD")
+        {
+            size_t comma = value.find(',');
+            valid = comma != std::string::npos && isDigits(value.substr(0, comma)) && isDigits(value.substr(comma + 1));
+        }
+        else if (command == "AT+CAL") valid = isDigits(value, true) && atoi(value.c_str()) >= -100 && atoi(value.c_str()) <= 100;
+
+        if (!valid) return "+ERR=2\r\n";
+        *parameter.value = value;
+        flashWrite = true;
+        module.flashWrites++;
+        return "+OK\r\n";
+    }
+    return "";
+}
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <count> [flash write time ms] [uid prefix]\n", argv[0]);
+        return 2;
+    }
+
+    int count = atoi(argv[1]);
+    int flashTime = argc > 2 ? atoi(argv[2]) : 20;
+    const char *prefix = argc > 3 ? argv[3] : "E0A1";
+
+    std::vector<Module> modules(count);
+    for (int i = 0; i < count; ++i)
+    {
+        if (!openPty(modules[i]))
+        {
+            fprintf(stderr, "Cannot create pty %d\n", i);
+            return 1;
+        }
+        char uid[32];
+        snprintf(uid, sizeof(uid), "%s%08X", prefix, (unsigned)i);
+        modules[i].uid = uid;
+        printf("%s %s\n", modules[i].path.c_str(), uid);
+    }
+    fflush(stdout);
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    std::vector<pollfd> fds(count);
+    while (running)
+    {
+        long long now = nowMs();
+        int timeout = 100;
+        for (int i = 0; i < count; ++i)
+        {
+            Module &module = modules[i];
+            if (!module.pending.empty())
+            {
+                if (now >= module.busyUntil)
+                {
+                    if (write(module.master, module.pending.data(), module.pending.size()) > 0) module.pending.clear();
+                }
+                else if (module.busyUntil - now < timeout)
+                {
+                    timeout = (int)(module.busyUntil - now);
+                }
+            }
+            fds[i].fd = module.master;
+            fds[i].events = POLLIN;
+            fds[i].revents = 0;
+        }
+
+        if (poll(fds.data(), count, timeout) <= 0) continue;
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (!(fds[i].revents & POLLIN)) continue;
+
+            Module &module = modules[i];
+            char buffer[256];
+            ssize_t received = read(module.master, buffer, sizeof(buffer));
+            if (received <= 0) continue;
+            module.input.append(buffer, (size_t)received);
+
+            size_t end;
+            while ((end = module.input.find("\r\n")) != std::string::npos)
+            {
+                std::string line = module.input.substr(0, end);
+                module.input.erase(0, end + 2);
+
+                bool flashWrite = false;
+                std::string response = execute(module, line, flashWrite);
+                if (response.empty()) response = "+ERR=1\r\n";
+
+                // The module is busy while it stores the value, also later commands wait
+                long long start = module.busyUntil > nowMs() ? module.busyUntil : nowMs();
+                module.busyUntil = flashWrite ? start + flashTime : start;
+                module.pending += response;
+            }
+        }
+    }
+
+    unsigned long flashWrites = 0;
+    for (const Module &module : modules) flashWrites += module.flashWrites;
+    fprintf(stderr, "Emulated %d modules, %lu flash writes\n", count, flashWrites);
+    return 0;
+}
@@ -0,0 +1,312 @@
+/*
+  ryuw122_provision.cpp - Configures many RYUW122 modules in parallel from a manifest.
+  Released into the public domain.
+
+  Usage: ryuw122_provision [--dry-run] <manifest> <serial port>...
+
+  Every port is handled by its own thread. The module is identified with AT+UID?, the desired
+  values are looked up in the manifest, every value is read first and only written when it
+  differs (each write costs a flash cycle and the module is busy while it stores it), and all
+  values are verified with the getters at the end. One line per module reports the result and
+  the time it took; the exit code is 0 only when every module was provisioned and verified.
+
+  Manifest: one module per line, "<UID> key=value ...", '#' starts a comment. A line with the
+  UID "*" holds defaults for all modules listed in the manifest. Keys:
+    address=<1-8 chars>  network=<1-8 chars>  password=<32 hex chars>  channel=5|9
+    bandwidth=0|1  tagd=<enable ms>,<disable ms> (0..28000 each)  cal=<-100..100>  mode=tag|anchor
+  An unknown key or a value outside these ranges stops the tool before any module is touched.
+*/
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "HostSerial.h"
+#include "RYUW122_UWB.h"
+
+namespace
+{
+typedef std::map<std::string, std::string> ModuleConfig;
+
+struct Field
+{
+    const char *key;
+    bool (*read)(RYUW122_UWB &uwb, std::string &value);
+    bool (*write)(RYUW122_UWB &uwb, const std::string &value);
+};
+
+std::string pad8(const std::string &value)
+{
+    std::string padded = value.substr(0, 8);
+    padded.resize(8, ' ');
+    return padded;
+}
+
+std::string trim(const char *value)
+{
+    std::string text(value);
+    while (!text.empty() && (text.back() == '\r' || text.back() == '\n' || text.back() == ' ')) text.pop_back();
+    return text;
+}
+
+bool parseInteger(const std::string &text, long min, long max, long &value)
+{
+    if (text.empty()) return false;
+    char *end = nullptr;
+    value = strtol(text.c_str(), &end, 10);
+    return *end == '\0' && value >= min && value <= max;
+}
+
+// Values are compared as the getters report them, so the manifest values are normalized the same way.
+// An invalid value is rejected instead, it must never turn into another valid one.
+bool normalize(const std::string &key, const std::string &value, std::string &normalized)
+{
+    long number, enable, disable;
+    size_t comma = value.find(',');
+    normalized = value;
+    if (key == "address" || key == "network")
+    {
+        if (value.empty() || value.size() > RYUW122_Address::Length || !RYUW122_Address::fromChars(value.c_str(), value.size()).isValid()) return false;
+        normalized = pad8(value);
+        return true;
+    }
+    if (key == "password") return value.size() == 32 && value.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos;
+    if (key == "channel") return value == "5" || value == "9";
+    if (key == "bandwidth") return value == "0" || value == "1";
+    if (key == "mode") return value == "tag" || value == "anchor";
+    if (key == "tagd")
+    {
+        if (comma == std::string::npos || !parseInteger(value.substr(0, comma), 0, 28000, enable) ||
+            !parseInteger(value.substr(comma + 1), 0, 28000, disable)) return false;
+        normalized = std::to_string(enable) + "," + std::to_string(disable);
+        return true;
+    }
+    if (key == "cal")
+    {
+        if (!parseInteger(value, -100, 100, number)) return false;
+        normalized = std::to_string(number);
+        return true;
+    }
+    return false;
+}
+
+bool parseTagParameters(const std::string &value, uint16_t &enableTime, uint16_t &disableTime)
+{
+    unsigned enable = 0, disable = 0;
+    if (sscanf(value.c_str(), "%u,%u", &enable, &disable) != 2) return false;
+    enableTime = (uint16_t)enable;
+    disableTime = (uint16_t)disable;
+    return true;
+}
+
+// Mode is written last: everything else is configured while the module is in its current mode
+const Field fields[] = {
+    {"address",
+     [](RYUW122_UWB &uwb, std::string &value) { char buffer[9]; if (!uwb.getAddress(buffer, sizeof(buffer))) return false; value = pad8(trim(buffer)); return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setAddress(value.c_str(), value.size()); }},
+    {"network",
+     [](RYUW122_UWB &uwb, std::string &value) { char buffer[9]; if (!uwb.getNetworkID(buffer, sizeof(buffer))) return false; value = pad8(trim(buffer)); return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setNetworkID(value.c_str(), value.size()); }},
+    {"password",
+     [](RYUW122_UWB &uwb, std::string &value) { char buffer[33]; if (!uwb.getPassword(buffer, sizeof(buffer))) return false; value = trim(buffer); return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setPassword(value.c_str(), value.size()); }},
+    {"channel",
+     [](RYUW122_UWB &uwb, std::string &value) { RYUW122_Channel channel; if (!uwb.getChannel(channel)) return false; value = channel == CHANNEL_7987_2_MHz ? "9" : "5"; return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setChannel(value == "9" ? CHANNEL_7987_2_MHz : value == "5" ? CHANNEL_6489_6_MHz : CHANNEL_UNKNOWN); }},
+    {"bandwidth",
+     [](RYUW122_UWB &uwb, std::string &value) { RYUW122_Bandwidth bandwidth; if (!uwb.getBandwidth(bandwidth)) return false; value = bandwidth == BANDWIDTH_6_8_Mbps ? "1" : "0"; return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setBandwidth(value == "1" ? BANDWIDTH_6_8_Mbps : value == "0" ? BANDWIDTH_850_Kbps : BANDWIDTH_UNKNOWN); }},
+    {"tagd",
+     [](RYUW122_UWB &uwb, std::string &value) { uint16_t enable, disable; if (!uwb.getTagParameters(enable, disable)) return false; value = std::to_string(enable) + "," + std::to_string(disable); return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { uint16_t enable, disable; return parseTagParameters(value, enable, disable) && uwb.setTagParameters(enable, disable); }},
+    {"cal",
+     [](RYUW122_UWB &uwb, std::string &value) { int8_t distance; if (!uwb.getCalibrationDistance(distance)) return false; value = std::to_string(distance); return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setCalibrationDistance((int8_t)atoi(value.c_str())); }},
+    {"mode",
+     [](RYUW122_UWB &uwb, std::string &value) { RYUW122_Mode mode; if (!uwb.getMode(mode)) return false; value = mode == MODE_ANCHOR ? "anchor" : mode == MODE_TAG ? "tag" : "sleep"; return true; },
+     [](RYUW122_UWB &uwb, const std::string &value) { return uwb.setMode(value == "anchor" ? MODE_ANCHOR : value == "tag" ? MODE_TAG : MODE_UNKNOWN); }},
+};
+
+const Field *findField(const std::string &key)
+{
+    for (const Field &field : fields)
+    {
+        if (key == field.key) return &field;
+    }
+    return nullptr;
+}
+
+bool loadManifest(const char *path, std::map<std::string, ModuleConfig> &manifest)
+{
+    std::ifstream file(path);
+    if (!file) return false;
+
+    ModuleConfig defaults;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream tokens(line);
+        std::string uid;
+        if (!(tokens >> uid)) continue;
+
+        ModuleConfig config;
+        std::string token;
+        while (tokens >> token)
+        {
+            size_t equals = token.find('=');
+            std::string key = token.substr(0, equals);
+            if (equals == std::string::npos || !findField(key))
+            {
+                fprintf(stderr, "%s:%d: unknown setting '%s'\n", path, lineNumber, token.c_str());
+                return false;
+            }
+            if (!normalize(key, token.substr(equals + 1), config[key]))
+            {
+                fprintf(stderr, "%s:%d: invalid value '%s'\n", path, lineNumber, token.c_str());
+                return false;
+            }
+        }
+
+        if (uid == "*") defaults = config;
+        else manifest[uid] = config;
+    }
+
+    for (auto &entry : manifest)
+    {
+        for (auto &value : defaults) entry.second.insert(value); // Explicit values win
+    }
+    return true;
+}
+
+struct Report
+{
+    std::string uid;
+    std::string status = "FAILED";
+    std::string detail;
+    int written = 0;
+    int skipped = 0;
+    long milliseconds = 0;
+};
+
+Report provision(const char *port, const std::map<std::string, ModuleConfig> &manifest, bool dryRun)
+{
+    Report report;
+    auto start = std::chrono::steady_clock::now();
+    auto finish = [&](const char *status, const std::string &detail) {
+        report.status = status;
+        report.detail = detail;
+        report.milliseconds = (long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    };
+
+    HostSerial serial;
+    if (!serial.begin(port, 115200)) return finish("FAILED", "cannot open port");
+
+    RYUW122_UWB uwb(serial);
+    RYUW122_RetryPolicy policy;
+    policy.maxRetries = 2; // Provisioning runs unattended, a single lost response must not fail the module
+    uwb.setRetryPolicy(policy);
+    if (!uwb.begin()) return finish("FAILED", "no response");
+
+    char uidBuffer[33];
+    if (!uwb.getUID(uidBuffer, sizeof(uidBuffer))) return finish("FAILED", "cannot read UID");
+    report.uid = trim(uidBuffer);
+
+    auto entry = manifest.find(report.uid);
+    if (entry == manifest.end()) return finish("UNKNOWN", "UID not in manifest");
+
+    std::string changes;
+    for (const Field &field : fields)
+    {
+        auto desired = entry->second.find(field.key);
+        if (desired == entry->second.end()) continue;
+
+        std::string current;
+        if (!field.read(uwb, current)) return finish("FAILED", std::string("cannot read ") + field.key);
+        if (current == desired->second)
+        {
+            report.skipped++;
+            continue;
+        }
+
+        changes += std::string(changes.empty() ? "" : " ") + field.key + ":" + current + "->" + desired->second;
+        if (dryRun) continue;
+        if (!field.write(uwb, desired->second)) return finish("FAILED", std::string("cannot write ") + field.key);
+        report.written++;
+    }
+
+    if (dryRun) return finish(changes.empty() ? "OK" : "DIFFERS", changes);
+
+    for (const Field &field : fields)
+    {
+        auto desired = entry->second.find(field.key);
+        if (desired == entry->second.end()) continue;
+
+        std::string current;
+        if (!field.read(uwb, current) || current != desired->second)
+        {
+            return finish("FAILED", std::string("verification of ") + field.key + " failed");
+        }
+    }
+    return finish("OK", changes);
+}
+}
+
+int main(int argc, char **argv)
+{
+    int first = 1;
+    bool dryRun = false;
+    if (argc > 1 && strcmp(argv[1], "--dry-run") == 0)
+    {
+        dryRun = true;
+        first++;
+    }
+
+    if (argc - first < 2)
+    {
+        fprintf(stderr, "Usage: %s [--dry-run] <manifest> <serial port>...\n", argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, ModuleConfig> manifest;
+    if (!loadManifest(argv[first], manifest))
+    {
+        fprintf(stderr, "Cannot load manifest %s\n", argv[first]);
+        return 2;
+    }
+
+    std::mutex outputMutex;
+    std::vector<std::thread> workers;
+    int failed = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = first + 1; i < argc; ++i)
+    {
+        const char *port = argv[i];
+        workers.emplace_back([&, port]() {
+            Report report = provision(port, manifest, dryRun);
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (report.status != "OK") failed++;
+            printf("%-16s %-20s %-8s written=%d skipped=%d time=%ldms %s\n", port, report.uid.empty() ? "-" : report.uid.c_str(),
+                   report.status.c_str(), report.written, report.skipped, report.milliseconds, report.detail.c_str());
+            fflush(stdout);
+        });
+    }
+    for (std::thread &worker : workers) worker.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%d of %d modules %s in %.2f s\n", argc - first - 1 - failed, argc - first - 1, dryRun ? "match" : "provisioned", seconds);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,307 @@
+/*
+  RYUW122_ShmRing.h - Shared memory ranging feed (single writer, many readers) for Linux gateways.
+  Released into the public domain.
+
+  The ring lives in a POSIX shared memory object (/dev/shm/<name>). Every slot is guarded by its own
+  sequence number (seqlock): 2n+1 while sample n is written, 2n+2 once it is complete. Readers never
+  write to the segment, never block the writer and need no syscalls after open(); a reader that falls
+  more than one ring behind detects the overrun from the sequence numbers and skips to the oldest
+  sample still available.
+
+  A restarted writer reuses a segment of the same capacity and bumps its generation (odd while the
+  slots are reset); readers notice it on the next read and continue with the first sample of the new
+  run. A segment of another capacity is never resized under mapped readers: the old object is marked
+  retired and unlinked, a new one is created under the name and readers are told to reopen it.
+
+  Link with -lrt on older glibc versions.
+*/
+
+#ifndef RYUW122_SHM_RING_H
+#define RYUW122_SHM_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct RYUW122_ShmSample
+{
+    uint64_t timestampUs;     // Host time when the range was parsed [us]
+    uint64_t address;         // RYUW122_Address::toUInt64(), 8 space padded characters
+    uint16_t distance;        // [cm]
+    uint8_t payloadLength;
+    char payload[13];         // 12 chars + null terminator
+};
+
+static_assert(sizeof(RYUW122_ShmSample) == 32, "Sample layout is part of the shared memory format");
+
+namespace RYUW122_Shm
+{
+constexpr uint32_t Magic = 0x52595557;  // "RYUW"
+constexpr uint32_t Version = 2;
+constexpr size_t SampleWords = sizeof(RYUW122_ShmSample) / sizeof(uint64_t);
+
+struct alignas(64) Slot
+{
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> words[SampleWords]; // Sample copied word by word, no torn reads of a single word
+};
+
+struct alignas(64) Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;                    // Number of slots, power of two
+    uint32_t slotSize;
+    std::atomic<uint32_t> retired;        // Set when a writer replaced the segment by a new object
+    std::atomic<uint64_t> generation;     // Incremented by every create(), odd while the slots are reset
+    alignas(64) std::atomic<uint64_t> published; // Number of samples published so far
+};
+
+inline size_t segmentSize(uint32_t capacity)
+{
+    return sizeof(Header) + (size_t)capacity * sizeof(Slot);
+}
+
+inline Slot *slots(Header *header)
+{
+    return reinterpret_cast<Slot *>(header + 1);
+}
+}
+
+class RYUW122_ShmWriter
+{
+public:
+    ~RYUW122_ShmWriter() { close(); }
+
+    // Creates the segment or takes over an existing one; capacity is rounded up to a power of two
+    bool create(const char *name, uint32_t capacity = 4096)
+    {
+        close();
+
+        uint32_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        size = RYUW122_Shm::segmentSize(rounded);
+
+        uint64_t generation = 0;
+        int fd = shm_open(name, O_RDWR, 0);
+        if (fd >= 0)
+        {
+            struct stat info;
+            void *memory = MAP_FAILED;
+            if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(RYUW122_Shm::Header))
+                memory = mmap(nullptr, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+
+            if (memory != MAP_FAILED)
+            {
+                RYUW122_Shm::Header *old = static_cast<RYUW122_Shm::Header *>(memory);
+                if (old->magic == RYUW122_Shm::Magic && old->version == RYUW122_Shm::Version &&
+                    old->slotSize == sizeof(RYUW122_Shm::Slot) && (size_t)info.st_size == size)
+                {
+                    // Same layout: readers stay mapped and follow the new generation
+                    header = old;
+                    initialize(rounded, old->generation.load(std::memory_order_relaxed));
+                    return true;
+                }
+
+                if (old->magic == RYUW122_Shm::Magic && old->version == RYUW122_Shm::Version)
+                {
+                    old->retired.store(1, std::memory_order_relaxed);
+                    old->generation.fetch_add(2, std::memory_order_release); // Readers check the flag on a new generation
+                }
+                munmap(memory, (size_t)info.st_size);
+            }
+            shm_unlink(name); // Readers keep the old object until they reopen, nothing shrinks under them
+        }
+
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, (off_t)size) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) return false;
+
+        header = static_cast<RYUW122_Shm::Header *>(memory);
+        header->magic = 0; // Readers reject the segment until it is initialized
+        initialize(rounded, generation);
+        return true;
+    }
+
+    void close()
+    {
+        if (header) munmap(header, size);
+        header = nullptr;
+    }
+
+    void publish(const RYUW122_ShmSample &sample)
+    {
+        uint64_t n = header->published.load(std::memory_order_relaxed);
+        RYUW122_Shm::Slot &slot = RYUW122_Shm::slots(header)[n & (header->capacity - 1)];
+
+        uint64_t words[RYUW122_Shm::SampleWords];
+        memcpy(words, &sample, sizeof(words));
+
+        slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < RYUW122_Shm::SampleWords; ++i)
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        slot.sequence.store(2 * n + 2, std::memory_order_release);
+
+        header->published.store(n + 1, std::memory_order_release);
+    }
+
+    uint64_t published() const { return header ? header->published.load(std::memory_order_relaxed) : 0; }
+
+private:
+    RYUW122_Shm::Header *header = nullptr;
+    size_t size = 0;
+
+    void initialize(uint32_t capacity, uint64_t previousGeneration)
+    {
+        uint64_t generation = (previousGeneration + 2) & ~1ULL; // Next even value
+        header->generation.store(generation - 1, std::memory_order_relaxed); // Odd: readers wait
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        header->version = RYUW122_Shm::Version;
+        header->capacity = capacity;
+        header->slotSize = sizeof(RYUW122_Shm::Slot);
+        header->retired.store(0, std::memory_order_relaxed);
+        header->published.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < capacity; ++i)
+            RYUW122_Shm::slots(header)[i].sequence.store(0, std::memory_order_relaxed);
+
+        header->generation.store(generation, std::memory_order_release);
+        reinterpret_cast<std::atomic<uint32_t> *>(&header->magic)->store(RYUW122_Shm::Magic, std::memory_order_release);
+    }
+};
+
+class RYUW122_ShmReader
+{
+public:
+    enum Status
+    {
+        SAMPLE,   // Sample copied
+        EMPTY,    // Nothing new yet
+        OVERRUN,  // Reader fell behind, samples were lost; the next read continues with the oldest available
+        RESTARTED, // Writer was restarted; the next read returns the first sample of the new run
+        CLOSED    // Segment was replaced by a new object (other capacity), open() it again
+    };
+
+    ~RYUW122_ShmReader() { close(); }
+
+    bool open(const char *name, bool fromLatest = true)
+    {
+        close();
+
+        int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(RYUW122_Shm::Header))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        size = (size_t)info.st_size;
+        void *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) return false;
+
+        header = static_cast<const RYUW122_Shm::Header *>(memory);
+        uint32_t magic = reinterpret_cast<const std::atomic<uint32_t> *>(&header->magic)->load(std::memory_order_acquire);
+        generation = header->generation.load(std::memory_order_acquire);
+        if (magic != RYUW122_Shm::Magic || header->version != RYUW122_Shm::Version || (generation & 1) ||
+            header->slotSize != sizeof(RYUW122_Shm::Slot) || size < RYUW122_Shm::segmentSize(header->capacity) ||
+            header->retired.load(std::memory_order_acquire))
+        {
+            close();
+            return false;
+        }
+
+        mask = header->capacity - 1;
+        next = fromLatest ? header->published.load(std::memory_order_acquire) : 0;
+        lost = 0;
+        return true;
+    }
+
+    void close()
+    {
+        if (header) munmap(const_cast<RYUW122_Shm::Header *>(header), size);
+        header = nullptr;
+    }
+
+    Status read(RYUW122_ShmSample &sample)
+    {
+        uint64_t current = header->generation.load(std::memory_order_acquire);
+        if (current != generation)
+        {
+            if (header->retired.load(std::memory_order_acquire)) return CLOSED;
+            if (current & 1) return EMPTY; // Writer is resetting the slots
+            generation = current;
+            next = 0;
+            return RESTARTED;
+        }
+
+        const RYUW122_Shm::Slot &slot = RYUW122_Shm::slots(const_cast<RYUW122_Shm::Header *>(header))[next & mask];
+        uint64_t expected = 2 * next + 2;
+
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before < expected) return EMPTY;
+        if (before == expected)
+        {
+            uint64_t words[RYUW122_Shm::SampleWords];
+            for (size_t i = 0; i < RYUW122_Shm::SampleWords; ++i)
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) == expected)
+            {
+                memcpy(&sample, words, sizeof(sample));
+                next++;
+                return SAMPLE;
+            }
+        }
+
+        if (header->generation.load(std::memory_order_acquire) != generation) return EMPTY; // Reported by the next read
+
+        // Slot was reused by a newer sample: skip to the oldest one that is still complete
+        uint64_t published = header->published.load(std::memory_order_acquire);
+        uint64_t oldest = published > header->capacity ? published - header->capacity + 1 : 0;
+        if (oldest > next)
+        {
+            lost += oldest - next;
+            next = oldest;
+        }
+        else
+        {
+            lost++;
+            next++;
+        }
+        return OVERRUN;
+    }
+
+    uint64_t lostSamples() const { return lost; }
+    uint64_t position() const { return next; }
+
+private:
+    const RYUW122_Shm::Header *header = nullptr;
+    size_t size = 0;
+    uint64_t mask = 0;
+    uint64_t next = 0;   // Sequence number of the next sample to read
+    uint64_t lost = 0;
+    uint64_t generation = 0;
+};
+
+#endif // RYUW122_SHM_RING_H
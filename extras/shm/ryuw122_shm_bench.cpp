@@ -0,0 +1,131 @@
+/*
+  ryuw122_shm_bench.cpp - Throughput benchmark of the shared memory ranging ring.
+  Released into the public domain.
+
+  Usage: ryuw122_shm_bench [samples] [readers] [capacity] [rate]
+  One writer thread publishes as fast as possible, every reader thread opens the segment on its own
+  (like a separate process would) and consumes it. A rate in samples per second paces the writer,
+  0 (default) publishes as fast as possible. Prints one JSON object with the rates.
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "RYUW122_ShmRing.h"
+
+namespace
+{
+const char *SegmentName = "/ryuw122_shm_bench";
+
+struct ReaderResult
+{
+    uint64_t samples = 0;
+    uint64_t lost = 0;
+    uint64_t corrupted = 0;
+};
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t total = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000ULL;
+    int readerCount = argc > 2 ? atoi(argv[2]) : 3;
+    uint32_t capacity = argc > 3 ? (uint32_t)strtoul(argv[3], nullptr, 10) : 4096;
+    double rate = argc > 4 ? atof(argv[4]) : 0.0;
+
+    RYUW122_ShmWriter writer;
+    if (!writer.create(SegmentName, capacity))
+    {
+        fprintf(stderr, "Cannot create shared memory\n");
+        return 1;
+    }
+
+    std::atomic<bool> done(false);
+    std::atomic<int> ready(0);
+    std::atomic<int> failed(0);
+    std::atomic<bool> aborted(false);
+    std::vector<ReaderResult> results(readerCount);
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < readerCount; ++r)
+    {
+        readers.emplace_back([&, r]()
+        {
+            RYUW122_ShmReader reader;
+            if (!reader.open(SegmentName, false))
+            {
+                failed++;
+                return;
+            }
+            ready++;
+
+            RYUW122_ShmSample sample;
+            ReaderResult &result = results[r];
+            for (;;)
+            {
+                RYUW122_ShmReader::Status status = reader.read(sample);
+                if (status == RYUW122_ShmReader::SAMPLE)
+                {
+                    result.samples++;
+                    if (sample.distance != (uint16_t)sample.timestampUs) result.corrupted++; // Writer stores the sequence in both
+                }
+                else if (status == RYUW122_ShmReader::EMPTY &&
+                         (aborted.load(std::memory_order_relaxed) || (done.load(std::memory_order_acquire) && reader.position() >= total)))
+                {
+                    break;
+                }
+            }
+            result.lost = reader.lostSamples();
+        });
+    }
+    while (ready.load() + failed.load() < readerCount) std::this_thread::yield();
+    if (failed.load() > 0)
+    {
+        fprintf(stderr, "%d reader(s) cannot open shared memory\n", failed.load());
+        aborted.store(true);
+        for (std::thread &reader : readers) reader.join();
+        shm_unlink(SegmentName);
+        return 1;
+    }
+
+    RYUW122_ShmSample sample;
+    memset(&sample, 0, sizeof(sample));
+    memcpy(sample.payload, "BENCH", 6);
+    sample.payloadLength = 5;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < total; ++i)
+    {
+        sample.timestampUs = i;
+        sample.address = 0x2020202020204142ULL + (i & 7);
+        sample.distance = (uint16_t)i;
+        writer.publish(sample);
+
+        if (rate > 0.0)
+        {
+            auto due = start + std::chrono::duration<double>((i + 1) / rate);
+            while (std::chrono::steady_clock::now() < due) {}
+        }
+    }
+    double writeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done.store(true, std::memory_order_release);
+
+    for (std::thread &reader : readers) reader.join();
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("{\"benchmark\":\"shm_ring\",\"samples\":%llu,\"capacity\":%u,\"readers\":%d,"
+           "\"target_rate\":%.0f,\"write_rate\":%.0f,\"write_ns_per_sample\":%.2f,\"readers_detail\":[",
+           (unsigned long long)total, capacity, readerCount, rate, total / writeSeconds, writeSeconds * 1e9 / total);
+    for (int r = 0; r < readerCount; ++r)
+    {
+        printf("%s{\"read\":%llu,\"lost\":%llu,\"corrupted\":%llu,\"read_rate\":%.0f}", r ? "," : "",
+               (unsigned long long)results[r].samples, (unsigned long long)results[r].lost,
+               (unsigned long long)results[r].corrupted, results[r].samples / totalSeconds);
+    }
+    printf("]}\n");
+
+    shm_unlink(SegmentName);
+    return 0;
+}
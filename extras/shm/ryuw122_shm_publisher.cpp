@@ -0,0 +1,122 @@
+/*
+  ryuw122_shm_publisher.cpp - Polls tags with an anchor module and publishes every range into shared memory.
+  Released into the public domain.
+
+  Usage: ryuw122_shm_publisher <serial port> <shm name> <tag address>...
+  Example: ryuw122_shm_publisher /dev/ttyUSB0 /ryuw122_ranges DAVID123 TAG2
+*/
+
+#include <signal.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <vector>
+
+#include "Arduino.h"
+#include "HostSerial.h"
+#include "RYUW122_UWB.h"
+#include "RYUW122_RateGovernor.h"
+#include "RYUW122_ShmRing.h"
+
+namespace
+{
+volatile sig_atomic_t running = 1;
+
+void stop(int)
+{
+    running = 0;
+}
+
+uint64_t wallClockMicros()
+{
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000ULL;
+}
+
+RYUW122_ShmSample toSample(const RYUW122_MessageInfo &info)
+{
+    RYUW122_ShmSample sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.timestampUs = wallClockMicros();
+    sample.address = RYUW122_Address::fromChars(info.address).toUInt64();
+    sample.distance = info.distance;
+    size_t payloadLen = strnlen(info.payload, sizeof(info.payload));
+    if (payloadLen > sizeof(sample.payload) - 1) payloadLen = sizeof(sample.payload) - 1;
+    sample.payloadLength = (uint8_t)payloadLen;
+    memcpy(sample.payload, info.payload, payloadLen);
+    return sample;
+}
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "Usage: %s <serial port> <shm name> <tag address>...\n", argv[0]);
+        return 2;
+    }
+
+    HostSerial serial;
+    if (!serial.begin(argv[1], 115200))
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    RYUW122_UWB uwb(serial);
+    if (!uwb.begin())
+    {
+        fprintf(stderr, "Module on %s does not respond\n", argv[1]);
+        return 1;
+    }
+
+    RYUW122_ShmWriter writer;
+    if (!writer.create(argv[2]))
+    {
+        fprintf(stderr, "Cannot create shared memory %s\n", argv[2]);
+        return 1;
+    }
+
+    int tagCount = argc - 3;
+    std::vector<RYUW122_Address> tags(tagCount);
+    for (int i = 0; i < tagCount; ++i)
+    {
+        tags[i] = RYUW122_Address::fromChars(argv[3 + i]);
+        if (!tags[i].isValid())
+        {
+            fprintf(stderr, "Invalid tag address %s\n", argv[3 + i]);
+            return 2;
+        }
+    }
+
+    RYUW122_RateGovernor governor;
+    uwb.setRateGovernor(&governor);
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    int current = 0;
+    RYUW122_MessageInfo info;
+    while (running)
+    {
+        if (!uwb.isAsyncMessageSend())
+        {
+            if (uwb.sendMessageAsync(tags[current], "R")) current = (current + 1) % tagCount;
+        }
+
+        if (uwb.receiveMessageAsyncAnchor(info) == MESSAGE_RECEIVED)
+        {
+            writer.publish(toSample(info));
+        }
+        while (uwb.receiveNext(info)) // Late responses are ranges too
+        {
+            if (info.address[0] != '\0') writer.publish(toSample(info));
+        }
+
+        delayMicroseconds(200);
+    }
+
+    fprintf(stderr, "Published %llu samples\n", (unsigned long long)writer.published());
+    return 0;
+}
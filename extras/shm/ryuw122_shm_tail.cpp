@@ -0,0 +1,58 @@
+/*
+  ryuw122_shm_tail.cpp - Prints ranges published by ryuw122_shm_publisher, one line per sample.
+  Released into the public domain.
+
+  Usage: ryuw122_shm_tail <shm name>
+*/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "RYUW122_ShmRing.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <shm name>\n", argv[0]);
+        return 2;
+    }
+
+    RYUW122_ShmReader reader;
+    if (!reader.open(argv[1]))
+    {
+        fprintf(stderr, "Cannot open shared memory %s\n", argv[1]);
+        return 1;
+    }
+
+    RYUW122_ShmSample sample;
+    for (;;)
+    {
+        switch (reader.read(sample))
+        {
+        case RYUW122_ShmReader::SAMPLE:
+        {
+            char address[9];
+            for (int i = 0; i < 8; ++i)
+                address[i] = (char)(sample.address >> (8 * i));
+            address[8] = '\0';
+            printf("%llu %s %u %s\n", (unsigned long long)sample.timestampUs, address, sample.distance, sample.payload);
+            break;
+        }
+        case RYUW122_ShmReader::OVERRUN:
+            fprintf(stderr, "Overrun, %llu samples lost in total\n", (unsigned long long)reader.lostSamples());
+            break;
+        case RYUW122_ShmReader::RESTARTED:
+            fprintf(stderr, "Publisher restarted\n");
+            break;
+        case RYUW122_ShmReader::CLOSED:
+            fprintf(stderr, "Shared memory replaced, reopening\n");
+            while (!reader.open(argv[1])) usleep(100000);
+            break;
+        case RYUW122_ShmReader::EMPTY:
+            fflush(stdout);
+            usleep(1000);
+            break;
+        }
+    }
+}
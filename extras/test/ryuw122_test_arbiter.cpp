@@ -0,0 +1,160 @@
+/*
+  ryuw122_test_arbiter.cpp - Request lifetime test of RYUW122_Arbiter.
+  Released into the public domain.
+
+  A client thread submits heap allocated ranging requests with a slow callback, waits for each one
+  and deletes it right after wait() returns, while the worker thread is still completing it. Build
+  with -fsanitize=address (or thread) to see an access after the request was freed; the program
+  also checks the callback count, a request that resubmits itself from its callback and isIdle().
+*/
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <Arduino.h>
+#include "RYUW122_Arbiter.h"
+
+// Answers every AT+ANCHOR_SEND like an anchor whose tag replies at once
+class EchoAnchor : public Stream
+{
+public:
+    size_t write(uint8_t c) override
+    {
+        line += (char)c;
+        if (c != '\n') return 1;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::string prefix = "AT+ANCHOR_SEND=";
+        if (line.compare(0, prefix.size(), prefix) == 0)
+        {
+            std::string command = line.substr(prefix.size(), line.size() - prefix.size() - 2);
+            for (char r : "OK\r\n+ANCHOR_RCV=" + command + ",123 cm\r\n") rx.push_back(r);
+        }
+        else
+        {
+            for (char r : std::string("OK\r\n")) rx.push_back(r);
+        }
+        line.clear();
+        return 1;
+    }
+
+    int available() override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return (int)rx.size();
+    }
+
+    int read() override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (rx.empty()) return -1;
+        char c = rx.front();
+        rx.pop_front();
+        return (uint8_t)c;
+    }
+
+    int peek() override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return rx.empty() ? -1 : (uint8_t)rx.front();
+    }
+
+private:
+    std::mutex mutex;
+    std::string line;
+    std::deque<char> rx;
+};
+
+struct Counters
+{
+    std::atomic<uint32_t> callbacks{0};
+    std::atomic<uint32_t> wrongResults{0};
+};
+
+static void slowCallback(RYUW122_Request &request, void *context)
+{
+    Counters &counters = *static_cast<Counters *>(context);
+    std::this_thread::sleep_for(std::chrono::microseconds(200)); // Window for the waiter to free the request
+    RYUW122_RangeRequest &range = static_cast<RYUW122_RangeRequest &>(request);
+    if (range.state != MESSAGE_RECEIVED || range.info.distance != 123) counters.wrongResults++;
+    counters.callbacks++;
+}
+
+struct Repeat
+{
+    RYUW122_Arbiter *arbiter;
+    uint32_t remaining;
+};
+
+static void resubmitCallback(RYUW122_Request &request, void *context)
+{
+    Repeat &repeat = *static_cast<Repeat *>(context);
+    if (--repeat.remaining > 0) repeat.arbiter->submit(static_cast<RYUW122_RangeRequest &>(request));
+}
+
+static int failures = 0;
+
+static void check(bool condition, const char *name)
+{
+    printf("%s %s\n", condition ? "PASS" : "FAIL", name);
+    if (!condition) failures++;
+}
+
+int main()
+{
+    EchoAnchor anchor;
+    RYUW122_UWB uwb(anchor);
+    RYUW122_Arbiter arbiter(uwb);
+
+    std::atomic<bool> stop(false);
+    std::thread worker([&]()
+    {
+        while (!stop.load()) arbiter.process();
+    });
+
+    const uint32_t requests = 2000;
+    Counters counters;
+    uint32_t completed = 0;
+    for (uint32_t i = 0; i < requests; ++i)
+    {
+        RYUW122_RangeRequest *request = new RYUW122_RangeRequest();
+        request->tag = RYUW122_Address("TAG1");
+        request->setCallback(slowCallback, &counters);
+        if (!arbiter.submit(*request)) break;
+        if (request->wait(1000)) completed++;
+        bool callbackDone = counters.callbacks.load() == completed;
+        delete request; // The worker must not touch the request any more
+        if (!callbackDone) break;
+    }
+    check(completed == requests, "every request completes");
+    check(counters.callbacks.load() == requests, "callback finished before wait() returned");
+    check(counters.wrongResults.load() == 0, "callback sees the results");
+
+    RYUW122_RangeRequest request;
+    request.tag = RYUW122_Address("TAG2");
+    Repeat repeat = {&arbiter, 5};
+    request.setCallback(resubmitCallback, &repeat);
+    arbiter.submit(request);
+    bool done = request.wait(1000);
+    check(done && repeat.remaining == 0, "callback can submit the request again");
+
+    stop.store(true);
+    worker.join();
+    check(arbiter.isIdle() && arbiter.getCompletedCount() == requests + 5, "idle and counted once every request is done");
+
+    // Queued work is pending work, whether the worker started it or not
+    RYUW122_RangeRequest range;
+    range.tag = RYUW122_Address("TAG3");
+    RYUW122_ConfigRequest config;
+    config.operation = [](RYUW122_UWB &uwb, void *) { return uwb.isConnected(); };
+    arbiter.submit(range);
+    arbiter.submit(config);
+    bool busy = !arbiter.isIdle();
+    for (int i = 0; i < 1000 && !arbiter.isIdle(); ++i) arbiter.process();
+    check(busy && arbiter.isIdle() && range.isDone() && config.isDone() && config.success, "not idle while requests are queued");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,153 @@
+/*
+  ryuw122_test_tiny.cpp - Full-length module lines through a RYUW122_PROFILE_TINY build.
+  Released into the public domain.
+
+  The module sends up to 12 payload characters on every profile; the tiny profile only keeps the
+  first RYUW122_MAX_PAYLOAD of them. Lines must still be read completely, otherwise the distance
+  at the end of +ANCHOR_RCV is cut off without an error.
+*/
+
+#include <deque>
+#include <functional>
+#include <string>
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+#include "RYUW122_Exporter.h"
+
+#if !RYUW122_PROFILE_TINY
+#error "Build with -DRYUW122_PROFILE_TINY=1"
+#endif
+
+static const char FullAnchorLine[] = "+ANCHOR_RCV=ANCHOR01,12,ABCDEFGHIJKL,1234 cm\r\n";
+
+class ReplyStream : public Stream
+{
+public:
+    std::function<void(const std::string &line)> responder;
+
+    size_t write(uint8_t c) override
+    {
+        line += (char)c;
+        if (c == '\n')
+        {
+            if (responder) responder(line);
+            line.clear();
+        }
+        return 1;
+    }
+
+    int available() override { return (int)rx.size(); }
+
+    int read() override
+    {
+        if (rx.empty()) return -1;
+        char c = rx.front();
+        rx.pop_front();
+        return (uint8_t)c;
+    }
+
+    int peek() override { return rx.empty() ? -1 : (uint8_t)rx.front(); }
+
+    void send(const std::string &text)
+    {
+        for (char c : text) rx.push_back(c);
+    }
+
+private:
+    std::string line;
+    std::deque<char> rx;
+};
+
+class CapturePrint : public Print
+{
+public:
+    std::string text;
+
+    size_t write(uint8_t c) override
+    {
+        text += (char)c;
+        return 1;
+    }
+};
+
+static int failures = 0;
+
+static void check(bool condition, const char *name)
+{
+    printf("%s %s\n", condition ? "PASS" : "FAIL", name);
+    if (!condition) failures++;
+}
+
+static bool isFullAnchorMessage(const RYUW122_MessageInfo &info)
+{
+    return info.distance == 1234 && info.payloadLength == 12 && strcmp(info.payload, "ABCD") == 0 &&
+           strcmp(info.address, "ANCHOR01") == 0;
+}
+
+int main()
+{
+    check(strlen(FullAnchorLine) > 41, "test line is longer than a buffer sized from RYUW122_MAX_PAYLOAD");
+
+    {
+        ReplyStream stream;
+        RYUW122_UWB uwb(stream);
+        RYUW122_MessageInfo info;
+        stream.send(FullAnchorLine);
+        check(uwb.receiveMessage(info, 50) && isFullAnchorMessage(info), "receiveMessage() keeps the distance");
+    }
+
+    {
+        ReplyStream stream;
+        RYUW122_UWB uwb(stream);
+        stream.responder = [&](const std::string &) { stream.send(std::string("OK\r\n") + FullAnchorLine); };
+        RYUW122_MessageInfo info;
+        RYUW122_MessageState state = MESSAGE_NOT_REQUESTED;
+        if (uwb.sendMessageAsync(RYUW122_Address("ANCHOR01"), "R"))
+        {
+            unsigned long start = millis();
+            do state = uwb.receiveMessageAsyncAnchor(info);
+            while (state == MESSAGE_WAITING && millis() - start < 500);
+        }
+        check(state == MESSAGE_RECEIVED && isFullAnchorMessage(info), "async anchor path keeps the distance");
+    }
+
+    {
+        ReplyStream stream;
+        RYUW122_UWB uwb(stream);
+        stream.responder = [&](const std::string &) { stream.send(std::string(FullAnchorLine) + "OK\r\n"); };
+        RYUW122_MessageInfo info;
+        bool connected = uwb.isConnected();
+        stream.responder = nullptr;
+        check(connected && uwb.receiveMessage(info, 50) && isFullAnchorMessage(info), "message captured during a command keeps the distance");
+    }
+
+    {
+        ReplyStream stream;
+        RYUW122_UWB uwb(stream);
+        RYUW122_MessageInfo info;
+        stream.send("+TAG_RCV=12,ABCDEFGHIJKL\r\n");
+        check(uwb.receiveMessageAsyncTag(info) == MESSAGE_RECEIVED && info.payloadLength == 12 && strcmp(info.payload, "ABCD") == 0,
+              "tag payload is truncated to RYUW122_MAX_PAYLOAD");
+    }
+
+    {
+        ReplyStream stream;
+        RYUW122_UWB uwb(stream);
+        RYUW122_MessageInfo info;
+        CapturePrint output;
+        RYUW122_Exporter exporter(output);
+        RYUW122_ExporterConfig config;
+        config.includePayload = true;
+        exporter.begin(config);
+        stream.send(FullAnchorLine);
+        bool added = uwb.receiveMessage(info, 50) && exporter.add(info, 7);
+        exporter.flush();
+        // Frame header (11), sample header, address, dt, distance (12), payload length and payload (5), CRC (2)
+        const std::string payload("\x04" "ABCD", 5);
+        check(added && output.text.size() == 30 && output.text.compare(23, payload.size(), payload) == 0,
+              "exporter writes the stored payload, not the announced length");
+    }
+
+    return failures ? 1 : 0;
+}
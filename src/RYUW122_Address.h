@@ -0,0 +1,217 @@
+/*
+  RYUW122_Address.h - Packed module address and address keyed map for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_ADDRESS_H
+#define RYUW122_ADDRESS_H
+
+#include <Arduino.h>
+
+/*
+  8 character, space padded module address packed into one uint64_t (character i in byte i).
+  A literal is packed and validated at compile time when the object is declared constexpr:
+
+      constexpr RYUW122_Address TAG("DAVID123");
+
+  Longer literals fail a static_assert, ',' '\r' '\n' fail the constant evaluation.
+  Value 0 is never a valid address and marks an empty address.
+*/
+class RYUW122_Address
+{
+public:
+    static constexpr size_t Length = 8;
+
+    constexpr RYUW122_Address() : value(0) {}
+
+    template <size_t N>
+    constexpr RYUW122_Address(const char (&address)[N]) : value(pack(address, N - 1, 0))
+    {
+        static_assert(N <= Length + 1, "RYUW122 address is limited to 8 characters");
+    }
+
+    static RYUW122_Address fromChars(const char *address, size_t len = 0)
+    {
+        if (!address) return RYUW122_Address();
+        if (len == 0) len = strnlen(address, Length + 1);
+        if (len > Length) return RYUW122_Address();
+
+        uint64_t packed = 0;
+        for (size_t i = 0; i < Length; ++i)
+        {
+            char c = ' ';
+            if (i < len)
+            {
+                if (address[i] == '\0') len = i; // Shorter null terminated string, pad the rest
+                else c = address[i];
+            }
+            if (c == ',' || c == '\r' || c == '\n') return RYUW122_Address();
+            packed |= (uint64_t)(uint8_t)c << (8 * i);
+        }
+        return RYUW122_Address(packed);
+    }
+
+    static constexpr RYUW122_Address fromUInt64(uint64_t value)
+    {
+        return RYUW122_Address(value);
+    }
+
+    constexpr uint64_t toUInt64() const { return value; }
+    constexpr bool isValid() const { return value != 0; }
+
+    void toChars(char *buffer) const // Writes exactly 8 characters, no null terminator
+    {
+        for (size_t i = 0; i < Length; ++i)
+            buffer[i] = (char)(value >> (8 * i));
+    }
+
+    void toString(char *buffer) const // Writes 8 characters and a null terminator
+    {
+        toChars(buffer);
+        buffer[Length] = '\0';
+    }
+
+    constexpr bool operator==(const RYUW122_Address &other) const { return value == other.value; }
+    constexpr bool operator!=(const RYUW122_Address &other) const { return value != other.value; }
+
+private:
+    uint64_t value;
+
+    constexpr explicit RYUW122_Address(uint64_t value) : value(value) {}
+
+    static uint8_t invalidAddressCharacter() { return 0; } // Not constexpr, fails a constant evaluation on purpose
+
+    static constexpr uint8_t validate(char c)
+    {
+        return (c == ',' || c == '\r' || c == '\n') ? invalidAddressCharacter() : (uint8_t)c;
+    }
+
+    static constexpr uint64_t padding(size_t i)
+    {
+        return i >= Length ? 0 : ((uint64_t)' ' << (8 * i)) | padding(i + 1);
+    }
+
+    static constexpr uint64_t pack(const char *address, size_t len, size_t i)
+    {
+        return i >= Length ? 0
+             : (i < len && address[i] != '\0') ? ((uint64_t)validate(address[i]) << (8 * i)) | pack(address, len, i + 1)
+             : padding(i);
+    }
+};
+
+/*
+  Fixed capacity open addressing map (linear probing) keyed by RYUW122_Address.
+  Keys live in their own flat array, so a lookup is a hash plus one integer compare per probed slot.
+  Capacity must be a power of two; nothing is allocated dynamically.
+*/
+template <typename Value, size_t Capacity>
+class RYUW122_AddressMap
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    RYUW122_AddressMap() { clear(); }
+
+    void clear()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            keys[i] = 0;
+        count = 0;
+    }
+
+    Value *find(const RYUW122_Address &address)
+    {
+        size_t slot = findSlot(address.toUInt64());
+        return slot < Capacity ? &values[slot] : nullptr;
+    }
+
+    const Value *find(const RYUW122_Address &address) const
+    {
+        size_t slot = findSlot(address.toUInt64());
+        return slot < Capacity ? &values[slot] : nullptr;
+    }
+
+    // Returns the existing value or a default constructed one, nullptr when the map is full
+    Value *insert(const RYUW122_Address &address)
+    {
+        uint64_t key = address.toUInt64();
+        if (key == 0) return nullptr;
+
+        size_t slot = hash(key);
+        for (size_t probe = 0; probe < Capacity; ++probe)
+        {
+            if (keys[slot] == key) return &values[slot];
+            if (keys[slot] == 0)
+            {
+                keys[slot] = key;
+                values[slot] = Value();
+                count++;
+                return &values[slot];
+            }
+            slot = (slot + 1) & (Capacity - 1);
+        }
+        return nullptr;
+    }
+
+    bool erase(const RYUW122_Address &address)
+    {
+        size_t slot = findSlot(address.toUInt64());
+        if (slot >= Capacity) return false;
+
+        keys[slot] = 0;
+        count--;
+
+        // Backward shift deletion keeps probe sequences intact without tombstones
+        size_t next = (slot + 1) & (Capacity - 1);
+        while (keys[next] != 0)
+        {
+            size_t home = hash(keys[next]);
+            if (((next - home) & (Capacity - 1)) >= ((next - slot) & (Capacity - 1)))
+            {
+                keys[slot] = keys[next];
+                values[slot] = values[next];
+                keys[next] = 0;
+                slot = next;
+            }
+            next = (next + 1) & (Capacity - 1);
+        }
+        return true;
+    }
+
+    size_t size() const { return count; }
+    bool full() const { return count == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Slot access for iteration: for (i = 0; i < capacity(); ++i) if (occupied(i)) ...
+    bool occupied(size_t slot) const { return keys[slot] != 0; }
+    RYUW122_Address keyAt(size_t slot) const { return RYUW122_Address::fromUInt64(keys[slot]); }
+    Value &valueAt(size_t slot) { return values[slot]; }
+    const Value &valueAt(size_t slot) const { return values[slot]; }
+
+private:
+    uint64_t keys[Capacity];
+    Value values[Capacity];
+    size_t count = 0;
+
+    static size_t hash(uint64_t key)
+    {
+        uint32_t folded = (uint32_t)key ^ (uint32_t)(key >> 32);
+        return (size_t)((folded * 2654435761UL) >> 16) & (Capacity - 1);
+    }
+
+    size_t findSlot(uint64_t key) const
+    {
+        if (key == 0) return Capacity;
+
+        size_t slot = hash(key);
+        for (size_t probe = 0; probe < Capacity; ++probe)
+        {
+            if (keys[slot] == key) return slot;
+            if (keys[slot] == 0) return Capacity;
+            slot = (slot + 1) & (Capacity - 1);
+        }
+        return Capacity;
+    }
+};
+
+#endif // RYUW122_ADDRESS_H
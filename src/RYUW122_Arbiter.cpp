@@ -0,0 +1,225 @@
+/*
+  RYUW122_Arbiter.cpp - Thread-safe request front-end for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_Arbiter.h"
+
+#ifdef RYUW122_ARBITER_SUPPORTED
+
+void RYUW122_Request::setCallback(Callback callback, void *context)
+{
+    this->callback = callback;
+    this->context = context;
+}
+
+RYUW122_RequestStatus RYUW122_Request::getStatus() const
+{
+    return (RYUW122_RequestStatus)status.load(std::memory_order_acquire);
+}
+
+bool RYUW122_Request::isDone() const
+{
+    return getStatus() == REQUEST_DONE;
+}
+
+bool RYUW122_Request::wait(unsigned long timeout) const
+{
+    unsigned long start = millis();
+    while (!isDone())
+    {
+        if (timeout != 0 && millis() - start >= timeout) return false;
+        delay(1); // Lets the worker task run, also when it has a lower priority
+    }
+    return true;
+}
+
+RYUW122_RequestQueue::RYUW122_RequestQueue() : head(&stub), tail(&stub) {}
+
+void RYUW122_RequestQueue::push(RYUW122_RequestNode *node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    RYUW122_RequestNode *previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release); // Until here the node is invisible to pop()
+}
+
+RYUW122_RequestNode *RYUW122_RequestQueue::pop()
+{
+    RYUW122_RequestNode *first = tail;
+    RYUW122_RequestNode *next = first->next.load(std::memory_order_acquire);
+
+    if (first == &stub) // Skip the stub that marks the empty queue
+    {
+        if (!next) return nullptr;
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next)
+    {
+        tail = next;
+        return first;
+    }
+
+    if (first != head.load(std::memory_order_acquire)) return nullptr; // A push is in progress
+
+    // Last element: put the stub behind it so that it can be unlinked
+    push(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+RYUW122_Arbiter::RYUW122_Arbiter(RYUW122_UWB &uwb) : uwb(uwb) {}
+
+bool RYUW122_Arbiter::submit(RYUW122_RangeRequest &request)
+{
+    if (!request.tag.isValid() || !request.message || !claim(request)) return false;
+    request.state = MESSAGE_WAITING;
+    pendingCount.fetch_add(1, std::memory_order_relaxed); // Before the push, the worker may complete it right away
+    rangeQueue.push(&request);
+    return true;
+}
+
+bool RYUW122_Arbiter::submit(RYUW122_ConfigRequest &request)
+{
+    if (!request.operation || !claim(request)) return false;
+    request.success = false;
+    pendingCount.fetch_add(1, std::memory_order_relaxed);
+    configQueue.push(&request);
+    return true;
+}
+
+void RYUW122_Arbiter::process()
+{
+    if (activeRange)
+    {
+        driveRange();
+        return;
+    }
+
+    RYUW122_ConfigRequest *config = nullptr;
+    if (rangeStreak >= RYUW122_ARBITER_MAX_RANGE_STREAK)
+    {
+        config = static_cast<RYUW122_ConfigRequest *>(static_cast<RYUW122_Request *>(configQueue.pop()));
+    }
+
+    if (!config)
+    {
+        RYUW122_RequestNode *range = rangeQueue.pop();
+        if (range)
+        {
+            if (rangeStreak < 255) rangeStreak++;
+            startRange(static_cast<RYUW122_RangeRequest *>(static_cast<RYUW122_Request *>(range)));
+            return;
+        }
+        config = static_cast<RYUW122_ConfigRequest *>(static_cast<RYUW122_Request *>(configQueue.pop()));
+    }
+
+    if (config)
+    {
+        rangeStreak = 0;
+        runConfig(config);
+    }
+}
+
+bool RYUW122_Arbiter::isIdle() const
+{
+    return pendingCount.load(std::memory_order_acquire) == 0;
+}
+
+uint32_t RYUW122_Arbiter::getCompletedCount() const
+{
+    return completedCount.load(std::memory_order_relaxed);
+}
+
+bool RYUW122_Arbiter::claim(RYUW122_Request &request)
+{
+    // A request that is still queued or running cannot be linked a second time
+    uint8_t status = request.status.load(std::memory_order_acquire);
+    do
+    {
+        if (status == REQUEST_QUEUED || status == REQUEST_RUNNING) return false; // COMPLETING: resubmitted from the callback
+    } while (!request.status.compare_exchange_weak(status, REQUEST_QUEUED, std::memory_order_acq_rel));
+
+    request.result = RESULT_NOT_EXECUTED;
+    request.errorCode = 0;
+    return true;
+}
+
+void RYUW122_Arbiter::startRange(RYUW122_RangeRequest *request)
+{
+    request->status.store(REQUEST_RUNNING, std::memory_order_release);
+    activeRange = request;
+    activeRangeSent = false;
+    driveRange();
+}
+
+void RYUW122_Arbiter::driveRange()
+{
+    RYUW122_RangeRequest &request = *activeRange;
+
+    if (!activeRangeSent)
+    {
+        if (!uwb.sendMessageAsync(request.tag, request.message, request.messageLen, request.padToMaxLength))
+        {
+            if (uwb.getLastResult() == RESULT_THROTTLED) return; // Rate governor delays the poll, try again later
+
+            request.state = MESSAGE_ERROR;
+            request.result = uwb.getLastResult();
+            request.errorCode = uwb.getLastErrorCode();
+            activeRange = nullptr;
+            complete(request);
+            return;
+        }
+        activeRangeSent = true;
+    }
+
+    RYUW122_MessageState state = uwb.receiveMessageAsyncAnchor(request.info);
+    if (state == MESSAGE_WAITING) return;
+
+    request.state = state;
+    request.result = state == MESSAGE_RECEIVED ? RESULT_OK : uwb.getLastResult();
+    request.errorCode = uwb.getLastErrorCode();
+    activeRange = nullptr;
+    complete(request);
+}
+
+void RYUW122_Arbiter::runConfig(RYUW122_ConfigRequest *request)
+{
+    request->status.store(REQUEST_RUNNING, std::memory_order_release);
+    request->success = request->operation(uwb, request->argument);
+    request->result = uwb.getLastResult();
+    request->errorCode = uwb.getLastErrorCode();
+    complete(*request);
+}
+
+void RYUW122_Arbiter::complete(RYUW122_Request &request)
+{
+    completedCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (!request.callback)
+    {
+        request.status.store(REQUEST_DONE, std::memory_order_release);
+        pendingCount.fetch_sub(1, std::memory_order_release); // Idle only once the request is DONE
+        return;
+    }
+
+    // The callback runs before DONE is published, so wait() cannot return and free the request under it
+    request.status.store(REQUEST_COMPLETING, std::memory_order_release);
+    request.callback(request, request.context);
+
+    // Last access: once the status is DONE the owner may reuse or destroy the request. A request
+    // submitted again by the callback is QUEUED and stays owned by the arbiter.
+    uint8_t status = REQUEST_COMPLETING;
+    request.status.compare_exchange_strong(status, REQUEST_DONE, std::memory_order_acq_rel);
+    pendingCount.fetch_sub(1, std::memory_order_release);
+}
+
+#endif // RYUW122_ARBITER_SUPPORTED
@@ -0,0 +1,155 @@
+/*
+  RYUW122_Arbiter.h - Thread-safe request front-end for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_ARBITER_H
+#define RYUW122_ARBITER_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+// The arbiter drives the anchor side and needs lock-free pointer atomics (ESP32, RP2040, Cortex-M3 and newer, Linux hosts)
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#include <atomic>
+#endif
+#endif
+
+#if defined(ATOMIC_POINTER_LOCK_FREE) && ATOMIC_POINTER_LOCK_FREE == 2 && RYUW122_HAS_ANCHOR
+#define RYUW122_ARBITER_SUPPORTED 1
+
+#ifndef RYUW122_ARBITER_MAX_RANGE_STREAK
+#define RYUW122_ARBITER_MAX_RANGE_STREAK 8 // Ranging requests served in a row before a waiting configuration request runs
+#endif
+
+enum RYUW122_RequestStatus : uint8_t
+{
+    REQUEST_IDLE = 0,     // Never submitted
+    REQUEST_QUEUED = 1,   // Waiting for the worker
+    REQUEST_RUNNING = 2,  // Executed by the worker
+    REQUEST_DONE = 3,     // Completed, results are valid and the request can be submitted again
+    REQUEST_COMPLETING = 4 // Results are valid, the callback is running; the worker still uses the request
+};
+
+struct RYUW122_RequestNode
+{
+    std::atomic<RYUW122_RequestNode *> next{nullptr};
+};
+
+/*
+  Common part of all requests. Requests are owned by the caller and linked into the queue
+  directly, nothing is allocated; keep a request alive until it is done.
+*/
+class RYUW122_Request : public RYUW122_RequestNode
+{
+public:
+    typedef void (*Callback)(RYUW122_Request &request, void *context);
+
+    // Called on the worker with the results before the request is done; it may submit the request again
+    void setCallback(Callback callback, void *context = nullptr);
+
+    RYUW122_RequestStatus getStatus() const;
+    bool isDone() const;
+
+    // Blocks the calling task until the request is done, 0 waits forever; never call it from the worker
+    bool wait(unsigned long timeout = 0) const;
+
+    RYUW122_Result result = RESULT_NOT_EXECUTED; // Result of the last module command
+    int16_t errorCode = 0;                       // +ERR=<n> code when result is RESULT_MODULE_ERROR
+
+private:
+    friend class RYUW122_Arbiter;
+
+    std::atomic<uint8_t> status{REQUEST_IDLE};
+    Callback callback = nullptr;
+    void *context = nullptr;
+};
+
+// Polls a tag and waits for its response (anchor mode)
+class RYUW122_RangeRequest : public RYUW122_Request
+{
+public:
+    RYUW122_Address tag;
+    const char *message = "R";   // Must stay valid until the request is done
+    size_t messageLen = 0;
+    bool padToMaxLength = false;
+
+    RYUW122_MessageState state = MESSAGE_NOT_REQUESTED;
+    RYUW122_MessageInfo info;
+};
+
+// Runs any sequence of blocking module calls, e.g. a getter or a setter
+class RYUW122_ConfigRequest : public RYUW122_Request
+{
+public:
+    typedef bool (*Operation)(RYUW122_UWB &uwb, void *argument);
+
+    Operation operation = nullptr;
+    void *argument = nullptr;
+    bool success = false;        // Value returned by the operation
+};
+
+/*
+  Intrusive multi-producer / single-consumer queue (Vyukov). push() is one atomic exchange and
+  never blocks or fails; pop() may miss an element whose push is still in progress and finds it
+  on the next call.
+*/
+class RYUW122_RequestQueue
+{
+public:
+    RYUW122_RequestQueue();
+
+    void push(RYUW122_RequestNode *node);
+    RYUW122_RequestNode *pop();
+
+private:
+    std::atomic<RYUW122_RequestNode *> head;
+    RYUW122_RequestNode *tail;
+    RYUW122_RequestNode stub;
+};
+
+/*
+  Owner of one RYUW122_UWB object. Any number of tasks or threads submit requests, a single
+  worker calls process() and is the only code that touches the module. Ranging requests are
+  served before configuration requests; after RYUW122_ARBITER_MAX_RANGE_STREAK ranging requests
+  in a row a waiting configuration request gets its turn, so it is never starved.
+
+  No lock is held while the module is busy: a ranging request is driven through the async anchor
+  path and process() returns while the response is pending, a configuration request blocks only
+  the worker.
+*/
+class RYUW122_Arbiter
+{
+public:
+    explicit RYUW122_Arbiter(RYUW122_UWB &uwb);
+
+    bool submit(RYUW122_RangeRequest &request);
+    bool submit(RYUW122_ConfigRequest &request);
+
+    void process();
+    bool isIdle() const; // Nothing queued or running: every submitted request is DONE. Any thread
+
+    uint32_t getCompletedCount() const; // Any thread
+
+private:
+    RYUW122_UWB &uwb;
+    RYUW122_RequestQueue rangeQueue;
+    RYUW122_RequestQueue configQueue;
+
+    RYUW122_RangeRequest *activeRange = nullptr;
+    bool activeRangeSent = false;
+    uint8_t rangeStreak = 0;
+    std::atomic<uint32_t> pendingCount{0};   // Submitted and not yet DONE
+    std::atomic<uint32_t> completedCount{0};
+
+    bool claim(RYUW122_Request &request);
+    void startRange(RYUW122_RangeRequest *request);
+    void driveRange();
+    void runConfig(RYUW122_ConfigRequest *request);
+    void complete(RYUW122_Request &request);
+};
+
+#endif // RYUW122_ARBITER_SUPPORTED
+
+#endif // RYUW122_ARBITER_H
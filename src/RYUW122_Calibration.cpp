@@ -0,0 +1,190 @@
+/*
+  RYUW122_Calibration.cpp - Automatic distance calibration (AT+CAL) for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_Calibration.h"
+
+#if RYUW122_HAS_ANCHOR
+
+RYUW122_Calibrator::RYUW122_Calibrator(RYUW122_UWB &uwb) : uwb(uwb) {}
+
+bool RYUW122_Calibrator::begin(const RYUW122_Address &tag, const RYUW122_CalibrationConfig &config)
+{
+    this->tag = tag;
+    this->config = config;
+    if (this->config.maxSamples > RYUW122_CALIBRATION_MAX_SAMPLES) this->config.maxSamples = RYUW122_CALIBRATION_MAX_SAMPLES;
+    if (this->config.minSamples < 2) this->config.minSamples = 2; // Variance needs at least two ranges
+    if (this->config.minSamples > this->config.maxSamples) this->config.minSamples = this->config.maxSamples;
+
+    result = RYUW122_CalibrationResult();
+    sampleCount = 0;
+
+    // A poll the library rejects would be rejected on every update
+    size_t messageLen = this->config.message ? strnlen(this->config.message, RYUW122_MAX_PAYLOAD + 1) : 0;
+
+    // Ranges are measured with the current offset, the correction is relative to it
+    if (!tag.isValid() || messageLen == 0 || messageLen > RYUW122_MAX_PAYLOAD ||
+        !uwb.getCalibrationDistance(result.previousOffset))
+    {
+        state = CALIBRATION_MODULE_ERROR;
+        return false;
+    }
+
+    state = CALIBRATION_MEASURING;
+    return true;
+}
+
+RYUW122_CalibrationState RYUW122_Calibrator::update()
+{
+    if (state != CALIBRATION_MEASURING) return state;
+
+    if (!uwb.isAsyncMessageSend())
+    {
+        if (uwb.sendMessageAsync(tag, config.message)) return state;
+        if (uwb.getLastResult() == RESULT_THROTTLED) return state; // Rate governor delays the poll, try again later
+        if (uwb.getLastResult() == RESULT_INVALID_ARGUMENT) return state = CALIBRATION_MODULE_ERROR;
+        return failedPoll(); // Write failure, counted like a poll without a range
+    }
+
+    RYUW122_MessageInfo info;
+    switch (uwb.receiveMessageAsyncAnchor(info))
+    {
+    case MESSAGE_RECEIVED:
+        if (RYUW122_Address::fromChars(info.address) != tag) return failedPoll(); // Response from another tag
+        addSample(info.distance);
+        if (estimate()) state = apply();
+        break;
+    case MESSAGE_TIMEOUT:
+    case MESSAGE_ERROR:
+    case MESSAGE_PARSE_ERROR:
+        return failedPoll(); // Every completed poll without a range counts, so run() always ends
+    default:
+        break;
+    }
+    return state;
+}
+
+RYUW122_CalibrationState RYUW122_Calibrator::run()
+{
+    while (update() == CALIBRATION_MEASURING)
+    {
+        yield();
+    }
+    return state;
+}
+
+RYUW122_CalibrationState RYUW122_Calibrator::getState() const
+{
+    return state;
+}
+
+const RYUW122_CalibrationResult &RYUW122_Calibrator::getResult() const
+{
+    return result;
+}
+
+RYUW122_CalibrationState RYUW122_Calibrator::failedPoll()
+{
+    if (++result.timeouts >= config.maxTimeouts) state = CALIBRATION_NO_RESPONSE;
+    return state;
+}
+
+void RYUW122_Calibrator::addSample(uint16_t distance)
+{
+    // Insertion keeps the array sorted, the median is then a simple lookup
+    uint8_t i = sampleCount++;
+    while (i > 0 && samples[i - 1] > distance)
+    {
+        samples[i] = samples[i - 1];
+        i--;
+    }
+    samples[i] = distance;
+}
+
+bool RYUW122_Calibrator::estimate()
+{
+    // Doubled values keep the median of an even count an integer
+    uint8_t mid = sampleCount / 2;
+    uint32_t median2 = sampleCount % 2 ? 2UL * samples[mid] : (uint32_t)samples[mid - 1] + samples[mid];
+
+    uint16_t deviations2[RYUW122_CALIBRATION_MAX_SAMPLES];
+    for (uint8_t i = 0; i < sampleCount; ++i)
+    {
+        uint32_t value2 = 2UL * samples[i];
+        uint16_t deviation2 = (uint16_t)(value2 > median2 ? value2 - median2 : median2 - value2);
+
+        uint8_t j = i;
+        while (j > 0 && deviations2[j - 1] > deviation2)
+        {
+            deviations2[j] = deviations2[j - 1];
+            j--;
+        }
+        deviations2[j] = deviation2;
+    }
+    float mad = (sampleCount % 2 ? deviations2[mid] : (deviations2[mid - 1] + deviations2[mid]) / 2.0f) / 2.0f;
+
+    // 1.4826 * MAD estimates sigma for normal noise; ranges are whole centimeters, so never reject +-1 cm
+    float limit = config.outlierThreshold * 1.4826f * mad;
+    if (limit < 1.0f) limit = 1.0f;
+
+    // Welford's method over the accepted ranges
+    float median = median2 / 2.0f;
+    uint8_t count = 0;
+    float mean = 0.0f;
+    float m2 = 0.0f;
+    for (uint8_t i = 0; i < sampleCount; ++i)
+    {
+        float value = samples[i];
+        if (fabs(value - median) > limit) continue;
+
+        count++;
+        float delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    result.samplesUsed = count;
+    result.samplesRejected = sampleCount - count;
+    result.measuredMean = mean;
+    result.confidenceHalfWidth = count >= 2 ? studentT95(count - 1) * sqrt(m2 / (count - 1) / count) : 1000.0f;
+
+    if (sampleCount >= config.maxSamples) return count > 0;
+    if (sampleCount < config.minSamples) return false;
+    return result.confidenceHalfWidth <= config.confidenceHalfWidth;
+}
+
+RYUW122_CalibrationState RYUW122_Calibrator::apply()
+{
+    float target = result.previousOffset + ((float)config.referenceDistance - result.measuredMean);
+    long offset = (long)floor(target + 0.5f);
+    if (offset < -100 || offset > 100) return CALIBRATION_OUT_OF_RANGE;
+
+    result.offset = (int8_t)offset;
+    result.residual = target - offset;
+
+    // Unchanged offset costs no flash write
+    if (result.offset != result.previousOffset && !uwb.setCalibrationDistance(result.offset))
+    {
+        return CALIBRATION_MODULE_ERROR;
+    }
+
+    int8_t readBack = 0;
+    if (!uwb.getCalibrationDistance(readBack) || readBack != result.offset)
+    {
+        return CALIBRATION_MODULE_ERROR;
+    }
+    return CALIBRATION_DONE;
+}
+
+float RYUW122_Calibrator::studentT95(uint8_t degreesOfFreedom)
+{
+    // Two-sided 95 % quantiles for small samples, the approximation stays within about 1 % above that
+    static const float table[] = {12.706f, 4.303f, 3.182f, 2.776f, 2.571f, 2.447f, 2.365f, 2.306f, 2.262f, 2.228f};
+    if (degreesOfFreedom == 0) return table[0];
+    if (degreesOfFreedom <= 10) return table[degreesOfFreedom - 1];
+    return 1.96f + 2.4f / degreesOfFreedom;
+}
+
+#endif // RYUW122_HAS_ANCHOR
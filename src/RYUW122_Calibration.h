@@ -0,0 +1,91 @@
+/*
+  RYUW122_Calibration.h - Automatic distance calibration (AT+CAL) for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_CALIBRATION_H
+#define RYUW122_CALIBRATION_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+#if RYUW122_HAS_ANCHOR
+
+#ifndef RYUW122_CALIBRATION_MAX_SAMPLES
+#define RYUW122_CALIBRATION_MAX_SAMPLES 32 // Upper limit of collected ranges, 2 bytes each
+#endif
+
+enum RYUW122_CalibrationState : int8_t
+{
+    CALIBRATION_DONE        =  2,  // Offset applied and read back
+    CALIBRATION_MEASURING   =  1,  // Collecting ranges, call update() again
+    CALIBRATION_IDLE        =  0,  // begin() was not called
+    CALIBRATION_NO_RESPONSE = -1,  // Too many polls without a range, tag not reachable
+    CALIBRATION_OUT_OF_RANGE = -2, // Required offset exceeds the -100..100 cm supported by the module
+    CALIBRATION_MODULE_ERROR = -3  // Reading, writing or verifying AT+CAL failed, or the poll was rejected as invalid
+};
+
+struct RYUW122_CalibrationConfig
+{
+    uint16_t referenceDistance = 100;  // True distance between anchor and tag antennas [cm]
+    uint8_t minSamples = 5;            // Ranges collected before the first stop check
+    uint8_t maxSamples = RYUW122_CALIBRATION_MAX_SAMPLES; // Stop even without reaching the confidence
+    float confidenceHalfWidth = 1.0f;  // Stop when the 95 % confidence interval of the mean is within +-this [cm]
+    float outlierThreshold = 3.0f;     // Reject ranges further than this many robust sigmas (MAD) from the median
+    uint8_t maxTimeouts = 10;          // Give up after this many polls without a range (timeout, +ERR, unparsable or foreign reply)
+    const char *message = "C";         // Poll payload (1..RYUW122_MAX_PAYLOAD chars), keep it the same length as in normal operation
+};
+
+struct RYUW122_CalibrationResult
+{
+    int8_t previousOffset = 0;         // AT+CAL value before the calibration [cm]
+    int8_t offset = 0;                 // Applied AT+CAL value [cm]
+    float measuredMean = 0.0f;         // Mean of accepted ranges, measured with the previous offset [cm]
+    float residual = 0.0f;             // Expected remaining error after rounding and clamping the offset [cm]
+    float confidenceHalfWidth = 0.0f;  // 95 % confidence interval half width of the mean [cm]
+    uint8_t samplesUsed = 0;           // Ranges accepted for the estimate
+    uint8_t samplesRejected = 0;       // Ranges rejected as outliers
+    uint8_t timeouts = 0;              // Polls without a range
+};
+
+/*
+  Calibrates the distance offset with a tag placed at a known reference distance.
+
+  Ranges are collected through the async anchor path, outliers are rejected around the median
+  using the median absolute deviation, and the collection stops as soon as the 95 % confidence
+  interval of the mean is narrow enough. The new offset assumes the module adds AT+CAL to the
+  reported distance: offset = previous offset + (reference - mean). It is written with
+  setCalibrationDistance() and verified with getCalibrationDistance().
+*/
+class RYUW122_Calibrator
+{
+public:
+    explicit RYUW122_Calibrator(RYUW122_UWB &uwb);
+
+    bool begin(const RYUW122_Address &tag, const RYUW122_CalibrationConfig &config = RYUW122_CalibrationConfig());
+    RYUW122_CalibrationState update();
+    RYUW122_CalibrationState run();
+
+    RYUW122_CalibrationState getState() const;
+    const RYUW122_CalibrationResult &getResult() const;
+
+private:
+    RYUW122_UWB &uwb;
+    RYUW122_Address tag;
+    RYUW122_CalibrationConfig config;
+    RYUW122_CalibrationResult result;
+    RYUW122_CalibrationState state = CALIBRATION_IDLE;
+
+    uint16_t samples[RYUW122_CALIBRATION_MAX_SAMPLES]; // Kept sorted for the median
+    uint8_t sampleCount = 0;
+
+    RYUW122_CalibrationState failedPoll();
+    void addSample(uint16_t distance);
+    bool estimate();
+    RYUW122_CalibrationState apply();
+    static float studentT95(uint8_t degreesOfFreedom);
+};
+
+#endif // RYUW122_HAS_ANCHOR
+
+#endif // RYUW122_CALIBRATION_H
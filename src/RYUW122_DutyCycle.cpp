@@ -0,0 +1,194 @@
+/*
+  RYUW122_DutyCycle.cpp - Adaptive tag RF duty cycle (AT+TAGD) for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_DutyCycle.h"
+
+#if RYUW122_HAS_TAG
+
+static const uint16_t MaxWindowTime = 28000; // Upper limit of both AT+TAGD windows [ms]
+static const uint16_t WindowStep = 10;       // Windows are rounded to this step so that noise does not cause writes [ms]
+
+RYUW122_DutyCycleController::RYUW122_DutyCycleController(RYUW122_UWB &uwb) : uwb(uwb) {}
+
+bool RYUW122_DutyCycleController::begin(const RYUW122_DutyCycleConfig &config)
+{
+    this->config = config;
+    period = 0.0f;
+    hasPoll = false;
+    flashWrites = 0;
+    successRate = 0.0f;
+    missedPollRate = 0.0f;
+    resetWindow(millis());
+
+    // Start from the windows stored in the module; the first decision compares against them
+    return uwb.getTagParameters(enableTime, disableTime);
+}
+
+RYUW122_MessageState RYUW122_DutyCycleController::receive(RYUW122_MessageInfo &info)
+{
+    RYUW122_MessageState state = uwb.receiveMessageAsyncTag(info);
+    if (state == MESSAGE_RECEIVED) recordPoll(millis());
+    return state;
+}
+
+void RYUW122_DutyCycleController::recordPoll(unsigned long now)
+{
+    if (windowPolls < 0xFFFF) windowPolls++;
+
+    if (hasPoll && now != lastPollTime)
+    {
+        float delta = (float)(now - lastPollTime);
+        if (period == 0.0f || delta < period * 0.75f)
+        {
+            period = delta; // Polls never come faster than the cadence, a shorter gap replaces an estimate taken across misses
+        }
+        else
+        {
+            uint32_t periods = (uint32_t)(delta / period + 0.5f);
+            if (periods <= 1)
+            {
+                period += (delta - period) * 0.125f;
+            }
+            else if (delta <= disableTime + 4.0f * period)
+            {
+                // Longer gaps mean that the anchor stopped polling, not that the tag missed polls
+                uint32_t missed = windowMissed + periods - 1;
+                windowMissed = missed < 0xFFFF ? missed : 0xFFFF;
+            }
+        }
+    }
+
+    lastPollTime = now;
+    hasPoll = true;
+}
+
+RYUW122_DutyCycleState RYUW122_DutyCycleController::update()
+{
+    unsigned long now = millis();
+    unsigned long elapsed = now - windowStart;
+    uint32_t cycle = (uint32_t)enableTime + disableTime;
+
+    if (elapsed < 2 * cycle) return DUTY_MEASURING; // Too short to see the windows at all
+    if (windowPolls < config.minSamples && elapsed < config.evaluationTimeout) return DUTY_MEASURING;
+
+    successRate = elapsed ? windowPolls * 1000.0f / elapsed : 0.0f;
+    missedPollRate = windowPolls ? (float)windowMissed / (windowPolls + windowMissed) : 0.0f;
+
+    uint16_t enable, disable;
+    plan(enable, disable);
+
+    float current = dutyCycle(enableTime, disableTime);
+    float proposed = dutyCycle(enable, disable);
+    bool underDelivering = successRate < config.targetRate && current < 1.0f;
+    if (underDelivering && proposed <= current)
+    {
+        // The estimate says the duty is enough, the measurement disagrees: keep the RF on
+        enable = 0;
+        disable = 0;
+        proposed = 1.0f;
+    }
+
+    bool write;
+    if (underDelivering)
+    {
+        write = true;
+    }
+    else
+    {
+        // RF on time saved until the next change is allowed, compared with the cost of the write
+        float saving = (current - proposed) * config.minWriteInterval / 1000.0f;
+        bool writeAllowed = lastWriteTime == 0 || now - lastWriteTime >= config.minWriteInterval;
+        write = writeAllowed && saving > config.writeCost;
+    }
+
+    resetWindow(now);
+    if (!write || (enable == enableTime && disable == disableTime)) return DUTY_STABLE;
+    if (flashWrites >= config.flashWriteBudget) return DUTY_BUDGET_EXHAUSTED;
+
+    flashWrites++;
+    if (!uwb.setTagParameters(enable, disable)) return DUTY_WRITE_FAILED;
+
+    enableTime = enable;
+    disableTime = disable;
+    lastWriteTime = millis();
+    if (lastWriteTime == 0) lastWriteTime = 1;
+    resetWindow(lastWriteTime); // Measurements from the old windows do not apply any more
+    return DUTY_UPDATED;
+}
+
+uint16_t RYUW122_DutyCycleController::getEnableTime() const
+{
+    return enableTime;
+}
+
+uint16_t RYUW122_DutyCycleController::getDisableTime() const
+{
+    return disableTime;
+}
+
+float RYUW122_DutyCycleController::getDutyCycle() const
+{
+    return dutyCycle(enableTime, disableTime);
+}
+
+float RYUW122_DutyCycleController::getPollPeriod() const
+{
+    return period;
+}
+
+float RYUW122_DutyCycleController::getMissedPollRate() const
+{
+    return missedPollRate;
+}
+
+float RYUW122_DutyCycleController::getSuccessRate() const
+{
+    return successRate;
+}
+
+float RYUW122_DutyCycleController::getEnergyPerRange() const
+{
+    return successRate > 0.0f ? getDutyCycle() / successRate : 0.0f;
+}
+
+uint32_t RYUW122_DutyCycleController::getFlashWrites() const
+{
+    return flashWrites;
+}
+
+float RYUW122_DutyCycleController::dutyCycle(uint16_t enableTime, uint16_t disableTime)
+{
+    if (enableTime == 0 || disableTime == 0) return 1.0f; // 0,0 keeps the RF on
+    return (float)enableTime / ((uint32_t)enableTime + disableTime);
+}
+
+void RYUW122_DutyCycleController::plan(uint16_t &enable, uint16_t &disable) const
+{
+    enable = 0;
+    disable = 0;
+    if (period == 0.0f) return; // Cadence unknown, stay reachable
+
+    // With a free-running cycle the tag answers duty / period polls per millisecond
+    float duty = config.margin * config.targetRate * period / 1000.0f;
+    float enableWindow = config.windowPolls * period + config.wakeGuard;
+    if (duty >= 1.0f || enableWindow > MaxWindowTime) return;
+
+    float disableWindow = enableWindow / duty - enableWindow;
+    if (disableWindow > MaxWindowTime) disableWindow = MaxWindowTime;
+
+    enable = (uint16_t)((enableWindow + WindowStep - 1) / WindowStep) * WindowStep;
+    disable = (uint16_t)(disableWindow / WindowStep) * WindowStep;
+    if (disable == 0) enable = 0;
+}
+
+void RYUW122_DutyCycleController::resetWindow(unsigned long now)
+{
+    windowStart = now;
+    windowPolls = 0;
+    windowMissed = 0;
+}
+
+#endif // RYUW122_HAS_TAG
@@ -0,0 +1,97 @@
+/*
+  RYUW122_DutyCycle.h - Adaptive tag RF duty cycle (AT+TAGD) for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_DUTY_CYCLE_H
+#define RYUW122_DUTY_CYCLE_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+#if RYUW122_HAS_TAG
+
+enum RYUW122_DutyCycleState : int8_t
+{
+    DUTY_UPDATED          =  2,  // New TAGD windows were written
+    DUTY_STABLE           =  1,  // Current windows are kept, a change would not pay off
+    DUTY_MEASURING        =  0,  // Not enough polls observed yet
+    DUTY_WRITE_FAILED     = -1,  // setTagParameters() failed
+    DUTY_BUDGET_EXHAUSTED = -2   // A change is needed, but the flash write budget is used up
+};
+
+struct RYUW122_DutyCycleConfig
+{
+    float targetRate = 1.0f;            // Successful ranges per second the anchor needs from this tag [Hz]
+    float margin = 1.5f;                // Headroom of the duty cycle over the computed minimum
+    uint8_t windowPolls = 2;            // Anchor polls that fit into one enable window
+    uint16_t wakeGuard = 10;            // RF start-up time added to the enable window [ms]
+    uint8_t minSamples = 16;            // Polls observed before a decision
+    uint32_t evaluationTimeout = 60000; // Decide after this time even with fewer polls [ms]
+    uint32_t minWriteInterval = 600000; // Shortest time between two TAGD writes, unless the tag under-delivers [ms]
+    float writeCost = 30.0f;            // Cost of one flash write (energy and wear) as seconds of RF on time
+    uint32_t flashWriteBudget = 100;    // Maximum number of TAGD writes done by the controller
+};
+
+/*
+  Adjusts the tag RF on/off windows (AT+TAGD) to the polling cadence of the anchor.
+
+  The anchor's poll period is estimated from +TAG_RCV arrival times; a gap of k periods counts
+  k - 1 missed polls. The enable window holds windowPolls polls plus the wake guard; the disable
+  window is chosen so that the duty cycle delivers targetRate * margin ranges per second with a
+  free-running cycle (successful rate ~ duty / period).
+
+  A new setting is written only when it pays off: the RF on time saved until the next possible
+  change (duty difference * minWriteInterval) must exceed writeCost. A tag that delivers less than
+  targetRate gets more duty immediately, limited only by the flash write budget.
+
+  AT+TAGD is written from update(); call it where the UART is known to answer, e.g. right after a
+  poll was received.
+*/
+class RYUW122_DutyCycleController
+{
+public:
+    explicit RYUW122_DutyCycleController(RYUW122_UWB &uwb);
+
+    bool begin(const RYUW122_DutyCycleConfig &config = RYUW122_DutyCycleConfig());
+
+    RYUW122_MessageState receive(RYUW122_MessageInfo &info); // Wraps receiveMessageAsyncTag() and records polls
+    void recordPoll(unsigned long now);                       // For polls received through another path
+    RYUW122_DutyCycleState update();
+
+    uint16_t getEnableTime() const;
+    uint16_t getDisableTime() const;
+    float getDutyCycle() const;            // Fraction of time the RF is enabled
+    float getPollPeriod() const;           // Estimated anchor poll period [ms], 0 while unknown
+    float getMissedPollRate() const;       // Fraction of anchor polls missed in the last evaluation window
+    float getSuccessRate() const;          // Polls answered per second in the last evaluation window [Hz]
+    float getEnergyPerRange() const;       // RF on time per answered poll [s]
+    uint32_t getFlashWrites() const;
+
+private:
+    RYUW122_UWB &uwb;
+    RYUW122_DutyCycleConfig config;
+
+    uint16_t enableTime = 0;
+    uint16_t disableTime = 0;
+    float period = 0.0f;
+
+    unsigned long lastPollTime = 0;
+    bool hasPoll = false;
+    unsigned long windowStart = 0;
+    uint16_t windowPolls = 0;
+    uint16_t windowMissed = 0;
+    float successRate = 0.0f;
+    float missedPollRate = 0.0f;
+
+    unsigned long lastWriteTime = 0;
+    uint32_t flashWrites = 0;
+
+    static float dutyCycle(uint16_t enableTime, uint16_t disableTime);
+    void plan(uint16_t &enable, uint16_t &disable) const;
+    void resetWindow(unsigned long now);
+};
+
+#endif // RYUW122_HAS_TAG
+
+#endif // RYUW122_DUTY_CYCLE_H
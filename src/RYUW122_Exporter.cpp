@@ -0,0 +1,327 @@
+/*
+  RYUW122_Exporter.cpp - Batched export of ranging results for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_Exporter.h"
+
+#if RYUW122_HAS_ANCHOR
+
+static const uint8_t FrameSync[2] = {0xA5, 0x5A};
+static const size_t BodyOffset = 5;    // Sync, version / flags, body length
+static const size_t HeaderSize = 11;   // ... base time, dictionary epoch, sample count
+static const size_t CrcSize = 2;
+
+static const uint8_t SampleAbsolute = 0x80;
+static const uint8_t SampleAddress = 0x40;
+
+// Bounded writer: once a value does not fit, everything after it is ignored and ok() is false
+class ExportWriter
+{
+public:
+    ExportWriter(uint8_t *start, uint8_t *end) : start(start), position(start), end(end) {}
+
+    void put(uint8_t value)
+    {
+        if (position < end) *position++ = value;
+        else overflow = true;
+    }
+
+    void putBytes(const void *data, size_t len)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < len; ++i) put(bytes[i]);
+    }
+
+    void putVarint(uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            put((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        put((uint8_t)value);
+    }
+
+    void putText(const char *text)
+    {
+        while (*text) put((uint8_t)*text++);
+    }
+
+    // Backslash before every character listed in special
+    void putEscaped(const char *text, size_t len, const char *special)
+    {
+        for (size_t i = 0; i < len && text[i]; ++i)
+        {
+            if (strchr(special, text[i])) put('\\');
+            put((uint8_t)text[i]);
+        }
+    }
+
+    void putNumber(uint32_t value)
+    {
+        char digits[10];
+        uint8_t count = 0;
+        do
+        {
+            digits[count++] = '0' + value % 10;
+            value /= 10;
+        } while (value);
+        while (count) put((uint8_t)digits[--count]);
+    }
+
+    bool ok() const { return !overflow; }
+    size_t length() const { return position - start; }
+
+private:
+    uint8_t *start;
+    uint8_t *position;
+    uint8_t *end;
+    bool overflow = false;
+};
+
+static uint16_t crc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF; // CRC-16/CCITT-FALSE
+    for (size_t i = 0; i < len; ++i)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; ++bit)
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+RYUW122_Exporter::RYUW122_Exporter(Print &output) : output(output) {}
+
+void RYUW122_Exporter::begin(const RYUW122_ExporterConfig &config)
+{
+    this->config = config;
+    used = 0;
+    sampleCount = 0;
+    tags.clear();
+    dictionaryReset = true;
+}
+
+bool RYUW122_Exporter::add(const RYUW122_MessageInfo &info, unsigned long now)
+{
+    RYUW122_Address address = RYUW122_Address::fromChars(info.address);
+    if (!address.isValid())
+    {
+        dropped++;
+        return false;
+    }
+
+    bool added = append(info, address, now);
+    if (!added)
+    {
+        flush(); // Batch or dictionary is full, the range starts the next frame
+        added = append(info, address, now);
+    }
+    if (!added)
+    {
+        if (sampleCount == 0) used = 0;
+        dropped++;
+        return false;
+    }
+
+    samples++;
+    if (used >= config.flushSize || now - batchStart >= config.flushInterval) flush();
+    return true;
+}
+
+void RYUW122_Exporter::update(unsigned long now)
+{
+    if (sampleCount > 0 && now - batchStart >= config.flushInterval) flush();
+}
+
+void RYUW122_Exporter::flush()
+{
+    if (sampleCount == 0)
+    {
+        used = 0;
+        return;
+    }
+
+    if (config.format == EXPORT_BINARY)
+    {
+        uint16_t bodyLength = used - BodyOffset;
+        buffer[3] = (uint8_t)bodyLength;
+        buffer[4] = (uint8_t)(bodyLength >> 8);
+        buffer[HeaderSize - 1] = sampleCount;
+
+        uint16_t crc = crc16(buffer + 2, used - 2); // Space for the CRC is always reserved
+        buffer[used++] = (uint8_t)crc;
+        buffer[used++] = (uint8_t)(crc >> 8);
+    }
+
+    output.write(buffer, used);
+    bytesWritten += used;
+    flushes++;
+    used = 0;
+    sampleCount = 0;
+}
+
+void RYUW122_Exporter::setEpochTime(uint32_t unixSeconds, unsigned long now)
+{
+    epochSeconds = unixSeconds;
+    epochReference = now;
+}
+
+uint32_t RYUW122_Exporter::getSampleCount() const
+{
+    return samples;
+}
+
+uint32_t RYUW122_Exporter::getDroppedCount() const
+{
+    return dropped;
+}
+
+uint32_t RYUW122_Exporter::getFlushCount() const
+{
+    return flushes;
+}
+
+uint32_t RYUW122_Exporter::getBytesWritten() const
+{
+    return bytesWritten;
+}
+
+bool RYUW122_Exporter::append(const RYUW122_MessageInfo &info, const RYUW122_Address &address, unsigned long now)
+{
+    if (sampleCount == 255) return false; // Count is one byte in the frame header
+    if (sampleCount == 0) batchStart = now;
+    return config.format == EXPORT_BINARY ? appendSample(info, address, now) : appendLine(info, address, now);
+}
+
+bool RYUW122_Exporter::appendSample(const RYUW122_MessageInfo &info, const RYUW122_Address &address, unsigned long now)
+{
+    if (sampleCount == 0)
+    {
+        if (dictionaryReset || now - dictionaryStart >= config.dictionaryInterval)
+        {
+            tags.clear(); // Decoders that joined late learn all addresses from the next frames
+            dictionaryStart = now;
+            epoch++;
+        }
+        for (size_t slot = 0; slot < tags.capacity(); ++slot)
+        {
+            if (tags.occupied(slot)) tags.valueAt(slot).inFrame = false;
+        }
+
+        ExportWriter header(buffer, buffer + HeaderSize);
+        header.putBytes(FrameSync, sizeof(FrameSync));
+        header.put(FrameVersion << 4 | (config.includePayload ? FlagPayload : 0));
+        header.put(0); // Body length and sample count are filled in by flush()
+        header.put(0);
+        header.put((uint8_t)now); // Base time, u32 little endian
+        header.put((uint8_t)(now >> 8));
+        header.put((uint8_t)(now >> 16));
+        header.put((uint8_t)(now >> 24));
+        header.put(epoch);
+        header.put(0);
+        used = HeaderSize;
+        lastTime = now;
+        dictionaryReset = false;
+    }
+
+    Tag *tag = tags.find(address);
+    if (!tag && tags.full())
+    {
+        dictionaryReset = true; // The next frame starts with an empty dictionary
+        return false;
+    }
+
+    ExportWriter writer(buffer + used, buffer + sizeof(buffer) - CrcSize);
+    uint8_t index = tag ? tag->index : (uint8_t)tags.size(); // Entries are only removed all at once, so sizes are unique
+    if (!tag)
+    {
+        char chars[RYUW122_Address::Length];
+        address.toChars(chars);
+        writer.put(SampleAbsolute | SampleAddress | index);
+        writer.putBytes(chars, sizeof(chars));
+        writer.putVarint(now - lastTime);
+        writer.putVarint(info.distance);
+    }
+    else if (!tag->inFrame)
+    {
+        writer.put(SampleAbsolute | index);
+        writer.putVarint(now - lastTime);
+        writer.putVarint(info.distance);
+    }
+    else
+    {
+        int32_t delta = (int32_t)info.distance - tag->distance;
+        writer.put(index);
+        writer.putVarint(now - lastTime);
+        writer.putVarint((uint32_t)(delta << 1) ^ (uint32_t)(delta >> 31)); // Zigzag: small changes of either sign take one byte
+    }
+    if (config.includePayload)
+    {
+        // payloadLength is what the module announced; the stored payload may have been truncated
+        uint8_t payloadLen = (uint8_t)strnlen(info.payload, sizeof(info.payload));
+        writer.put(payloadLen);
+        writer.putBytes(info.payload, payloadLen);
+    }
+    if (!writer.ok()) return false;
+
+    // Commit the dictionary and frame state only once the sample is in the buffer
+    if (!tag)
+    {
+        tag = tags.insert(address);
+        tag->index = index;
+    }
+    tag->distance = info.distance;
+    tag->inFrame = true;
+    used += writer.length();
+    lastTime = now;
+    sampleCount++;
+    return true;
+}
+
+bool RYUW122_Exporter::appendLine(const RYUW122_MessageInfo &info, const RYUW122_Address &address, unsigned long now)
+{
+    (void)address;
+    size_t addressLen = strnlen(info.address, RYUW122_Address::Length);
+    while (addressLen > 0 && info.address[addressLen - 1] == ' ') addressLen--; // Padding is not part of the name
+
+    ExportWriter writer(buffer + used, buffer + sizeof(buffer));
+    writer.putEscaped(config.measurement, strlen(config.measurement), ", ");
+    if (config.anchor)
+    {
+        writer.putText(",anchor=");
+        writer.putEscaped(config.anchor, strlen(config.anchor), ", =");
+    }
+    writer.putText(",tag=");
+    writer.putEscaped(info.address, addressLen, ", =");
+    writer.putText(" distance=");
+    writer.putNumber(info.distance);
+    writer.put('i');
+    if (config.includePayload)
+    {
+        writer.putText(",payload=\"");
+        writer.putEscaped(info.payload, strnlen(info.payload, sizeof(info.payload)), "\"\\");
+        writer.put('"');
+    }
+    if (epochSeconds)
+    {
+        // Unix milliseconds as seconds and three digits, no 64-bit division on 8-bit targets
+        unsigned long elapsed = now - epochReference;
+        uint16_t millisecond = elapsed % 1000;
+        writer.put(' ');
+        writer.putNumber(epochSeconds + elapsed / 1000);
+        writer.put('0' + millisecond / 100);
+        writer.put('0' + millisecond / 10 % 10);
+        writer.put('0' + millisecond % 10);
+    }
+    writer.put('\n');
+    if (!writer.ok()) return false;
+
+    used += writer.length();
+    sampleCount++;
+    return true;
+}
+
+#endif // RYUW122_HAS_ANCHOR
@@ -0,0 +1,122 @@
+/*
+  RYUW122_Exporter.h - Batched export of ranging results for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_EXPORTER_H
+#define RYUW122_EXPORTER_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+#if RYUW122_HAS_ANCHOR
+
+#ifndef RYUW122_EXPORT_BUFFER_SIZE
+#define RYUW122_EXPORT_BUFFER_SIZE 128 // Largest frame / line batch [bytes]
+#endif
+
+#ifndef RYUW122_EXPORT_MAX_TAGS
+#define RYUW122_EXPORT_MAX_TAGS 16 // Tags in the binary address dictionary (power of two, at most 64)
+#endif
+
+#if RYUW122_EXPORT_MAX_TAGS > 64
+#error "RYUW122_EXPORT_MAX_TAGS is limited to 64 by the sample header"
+#endif
+
+enum RYUW122_ExportFormat : uint8_t
+{
+    EXPORT_BINARY = 0,         // Delta encoded frames, decoded by extras/export
+    EXPORT_LINE_PROTOCOL = 1   // InfluxDB line protocol, one line per range
+};
+
+struct RYUW122_ExporterConfig
+{
+    RYUW122_ExportFormat format = EXPORT_BINARY;
+    uint16_t flushSize = 96;            // Batch is written once it holds this many bytes [bytes]
+    uint16_t flushInterval = 100;       // Batch is written once its oldest range is this old [ms]
+    bool includePayload = false;        // Export the tag response message as well
+    uint16_t dictionaryInterval = 1000; // Tag addresses are sent again after this time, a late decoder waits at most this long [ms]
+    const char *measurement = "ryuw122"; // Line protocol measurement
+    const char *anchor = nullptr;       // Line protocol anchor tag value, nullptr leaves the tag out
+};
+
+/*
+  Collects ranges in one buffer and writes them to a Print (second UART, USB CDC) in batches
+  instead of printing every field.
+
+  Binary frame (integers little endian, varints in LEB128):
+
+      A5 5A  version << 4 | flags  body length (u16)  body  CRC-16/CCITT (u16, version to end of body)
+      body:    base time (u32, ms)  dictionary epoch (u8)  sample count (u8)  samples
+      sample:  header  [address (8 chars)]  dt (varint)  distance or distance delta (varint)  [payload]
+      header:  0x80 absolute distance, 0x40 address follows, bits 0-5 tag index
+
+  Tags are numbered in an address dictionary; the address is sent with the first sample of a tag
+  after a dictionary reset, which happens every dictionaryInterval or when the dictionary is full
+  and increments the epoch. The first sample of a tag in a frame carries the absolute distance, later
+  ones the zigzag encoded change, so a lost frame never corrupts the next one. dt is the time
+  since the previous sample of the frame. With flag 0x01 (includePayload) every sample ends with
+  payload length (u8) and payload. A typical sample takes 3 to 4 bytes.
+
+  Line protocol: <measurement>[,anchor=<anchor>],tag=<address> distance=<cm>i[,payload="..."] [<timestamp>]
+  InfluxDB reads a timestamp as Unix time, so lines carry none until setEpochTime() and the server
+  stamps their arrival (up to flushInterval late). After setEpochTime() the timestamp is Unix time in
+  milliseconds; write with precision=ms.
+*/
+class RYUW122_Exporter
+{
+public:
+    static constexpr uint8_t FrameVersion = 1;
+    static constexpr uint8_t FlagPayload = 0x01;
+
+    explicit RYUW122_Exporter(Print &output);
+
+    void begin(const RYUW122_ExporterConfig &config = RYUW122_ExporterConfig());
+    bool add(const RYUW122_MessageInfo &info, unsigned long now);
+    void update(unsigned long now); // Writes the batch when flushInterval expired
+    void flush();
+
+    // Unix time at millis() == now, e.g. from NTP or an RTC; line protocol timestamps are derived from it
+    void setEpochTime(uint32_t unixSeconds, unsigned long now);
+
+    uint32_t getSampleCount() const;
+    uint32_t getDroppedCount() const; // Ranges that did not fit into an empty batch
+    uint32_t getFlushCount() const;
+    uint32_t getBytesWritten() const;
+
+private:
+    struct Tag
+    {
+        uint8_t index = 0;
+        uint16_t distance = 0; // Last distance in the current frame
+        bool inFrame = false;
+    };
+
+    Print &output;
+    RYUW122_ExporterConfig config;
+
+    uint8_t buffer[RYUW122_EXPORT_BUFFER_SIZE];
+    size_t used = 0;
+    unsigned long batchStart = 0;
+    unsigned long lastTime = 0;
+    uint8_t sampleCount = 0;
+    RYUW122_AddressMap<Tag, RYUW122_EXPORT_MAX_TAGS> tags; // Address dictionary of the binary format
+    unsigned long dictionaryStart = 0;
+    uint8_t epoch = 0;
+    bool dictionaryReset = true;
+    uint32_t epochSeconds = 0;          // 0 while the Unix time is unknown
+    unsigned long epochReference = 0;
+
+    uint32_t samples = 0;
+    uint32_t dropped = 0;
+    uint32_t flushes = 0;
+    uint32_t bytesWritten = 0;
+
+    bool append(const RYUW122_MessageInfo &info, const RYUW122_Address &address, unsigned long now);
+    bool appendSample(const RYUW122_MessageInfo &info, const RYUW122_Address &address, unsigned long now);
+    bool appendLine(const RYUW122_MessageInfo &info, const RYUW122_Address &address, unsigned long now);
+};
+
+#endif // RYUW122_HAS_ANCHOR
+
+#endif // RYUW122_EXPORTER_H
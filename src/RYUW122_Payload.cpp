@@ -0,0 +1,62 @@
+/*
+  RYUW122_Payload.cpp - Compile-time schema codec for binary telemetry in RYUW122 messages.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_Payload.h"
+
+// '!'..'*' are digits 0..9, '-'..'~' are digits 10..91; '+' and ',' are skipped
+static const char FirstDigit = '!';
+static const char SkippedFrom = '+';
+static const uint8_t SkippedCount = 2;
+
+void RYUW122_PayloadNumber::clear()
+{
+    memset(bytes, 0, sizeof(bytes));
+}
+
+void RYUW122_PayloadNumber::multiplyAdd(uint32_t factor, uint32_t addend)
+{
+    // byte * factor + carry stays below 2^32 for factor <= 2^24
+    uint32_t carry = addend;
+    for (size_t i = 0; i < Size; ++i)
+    {
+        uint32_t value = (uint32_t)bytes[i] * factor + carry;
+        bytes[i] = (uint8_t)value;
+        carry = value >> 8;
+    }
+}
+
+uint32_t RYUW122_PayloadNumber::divide(uint32_t divisor)
+{
+    uint32_t remainder = 0;
+    for (size_t i = Size; i-- > 0;)
+    {
+        uint32_t value = (remainder << 8) | bytes[i];
+        bytes[i] = (uint8_t)(value / divisor);
+        remainder = value % divisor;
+    }
+    return remainder;
+}
+
+bool RYUW122_PayloadNumber::isZero() const
+{
+    for (size_t i = 0; i < Size; ++i)
+        if (bytes[i] != 0) return false;
+    return true;
+}
+
+char RYUW122_PayloadNumber::toChar(uint8_t digit)
+{
+    char c = FirstDigit + digit;
+    return c < SkippedFrom ? c : c + SkippedCount;
+}
+
+int8_t RYUW122_PayloadNumber::fromChar(char c)
+{
+    if (c < FirstDigit || c > '~') return -1;
+    if (c < SkippedFrom) return c - FirstDigit;
+    if (c < SkippedFrom + SkippedCount) return -1;
+    return c - FirstDigit - SkippedCount;
+}
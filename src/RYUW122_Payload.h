@@ -0,0 +1,241 @@
+/*
+  RYUW122_Payload.h - Compile-time schema codec for binary telemetry in RYUW122 messages.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_PAYLOAD_H
+#define RYUW122_PAYLOAD_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "RYUW122_UWB.h"
+
+/*
+  Unsigned number of RYUW122_MAX_PAYLOAD base-92 digits, used by RYUW122_PayloadCodec.
+  Digits are the printable characters '!'..'~' without '+' and ',': a payload can never contain
+  ',' (field separator), CR / LF (line end) or "+ERR=" / "+..._RCV=" (response prefixes).
+*/
+class RYUW122_PayloadNumber
+{
+public:
+    static constexpr uint8_t Base = 92;
+    static constexpr size_t Size = (RYUW122_MAX_PAYLOAD * 7 + 7) / 8; // 92 < 2^7, so every digit fits into 7 bits
+
+    RYUW122_PayloadNumber() { clear(); }
+
+    void clear();
+    void multiplyAdd(uint32_t factor, uint32_t addend); // number = number * factor + addend, factor <= 2^24, addend < factor
+    uint32_t divide(uint32_t divisor);                  // number /= divisor, returns the remainder; divisor <= 2^24
+    bool isZero() const;
+
+    static char toChar(uint8_t digit);
+    static int8_t fromChar(char c); // -1 for a character outside the alphabet
+
+    // Compile-time helpers for the codec length. Integer arithmetic, so that the layout is the same on
+    // every target (double is 32 bits on AVR); values above 2^96 saturate, far beyond 12 digits.
+    struct Wide
+    {
+        uint64_t high;
+        uint64_t low;
+    };
+
+    static constexpr Wide multiply(Wide value, uint32_t factor)
+    {
+        return value.high > 0xFFFFFFFFULL ? Wide{~0ULL, ~0ULL}
+             : carry(value.high * factor, (value.low & 0xFFFFFFFFULL) * factor, (value.low >> 32) * factor);
+    }
+
+    static constexpr bool lessOrEqual(Wide a, Wide b)
+    {
+        return a.high != b.high ? a.high < b.high : a.low <= b.low;
+    }
+
+    // Number of base-92 digits needed to hold the given number of different values
+    static constexpr size_t digits(Wide values, Wide capacity = Wide{0, 1}, size_t count = 0)
+    {
+        return lessOrEqual(values, capacity) ? count : digits(values, multiply(capacity, Base), count + 1);
+    }
+
+private:
+    uint8_t bytes[Size]; // Little endian
+
+    static constexpr Wide carry(uint64_t high, uint64_t low0, uint64_t low1)
+    {
+        return join(high, low0, low1 + (low0 >> 32));
+    }
+
+    static constexpr Wide join(uint64_t high, uint64_t low0, uint64_t low1)
+    {
+        return Wide{high + (low1 >> 32), (low1 << 32) | (low0 & 0xFFFFFFFFULL)};
+    }
+};
+
+// Integer of 1..24 bits, larger values are clamped
+template <uint8_t Bits>
+struct RYUW122_UIntField
+{
+    static_assert(Bits >= 1 && Bits <= 24, "Field width must be 1..24 bits");
+    typedef uint32_t Value;
+    static constexpr uint32_t Range = (uint32_t)1 << Bits;
+
+    static uint32_t toDigit(Value value) { return value < Range ? value : Range - 1; }
+    static Value fromDigit(uint32_t digit) { return digit; }
+};
+
+// Two's complement range of 1..24 bits, e.g. 12 bits hold -2048..2047; values outside are clamped
+template <uint8_t Bits>
+struct RYUW122_IntField
+{
+    static_assert(Bits >= 1 && Bits <= 24, "Field width must be 1..24 bits");
+    typedef int32_t Value;
+    static constexpr uint32_t Range = (uint32_t)1 << Bits;
+
+    static uint32_t toDigit(Value value)
+    {
+        const int32_t min = -(int32_t)(Range / 2);
+        const int32_t max = (int32_t)(Range / 2) - 1;
+        return (uint32_t)((value < min ? min : value > max ? max : value) - min);
+    }
+    static Value fromDigit(uint32_t digit) { return (int32_t)digit - (int32_t)(Range / 2); }
+};
+
+// Integer in [Min, Max]; only the values that can occur take space, e.g. 0..99 needs 6.64 bits
+template <int32_t Min, int32_t Max>
+struct RYUW122_RangeField
+{
+    static_assert(Min < Max && (uint32_t)(Max - Min) < ((uint32_t)1 << 24), "Range must hold 2..2^24 values");
+    typedef int32_t Value;
+    static constexpr uint32_t Range = (uint32_t)(Max - Min) + 1;
+
+    static uint32_t toDigit(Value value) { return (uint32_t)((value < Min ? Min : value > Max ? Max : value) - Min); }
+    static Value fromDigit(uint32_t digit) { return (int32_t)digit + Min; }
+};
+
+// Fixed point value: Min and Max are given in units of 1 / Scale, e.g. <-400, 850, 10> is -40.0..85.0 in steps of 0.1
+template <int32_t Min, int32_t Max, uint16_t Scale = 1>
+struct RYUW122_FixedField
+{
+    static_assert(Min < Max && (uint32_t)(Max - Min) < ((uint32_t)1 << 24), "Range must hold 2..2^24 steps");
+    static_assert(Scale > 0, "Scale must not be 0");
+    typedef float Value;
+    static constexpr uint32_t Range = (uint32_t)(Max - Min) + 1;
+
+    static uint32_t toDigit(Value value)
+    {
+        float scaled = value * Scale;
+        if (!(scaled > Min)) return 0; // Also NaN
+        if (scaled >= Max) return Range - 1;
+        return (uint32_t)(int32_t)(floorf(scaled + 0.5f) - Min);
+    }
+    static Value fromDigit(uint32_t digit) { return (float)((int32_t)digit + Min) / Scale; }
+};
+
+struct RYUW122_FlagField
+{
+    typedef bool Value;
+    static constexpr uint32_t Range = 2;
+
+    static uint32_t toDigit(Value value) { return value ? 1 : 0; }
+    static Value fromDigit(uint32_t digit) { return digit != 0; }
+};
+
+// Recursion over the schema; the first field is the least significant digit of the mixed-radix number
+template <typename... Fields>
+struct RYUW122_PayloadFields
+{
+    static constexpr RYUW122_PayloadNumber::Wide values() { return RYUW122_PayloadNumber::Wide{0, 1}; }
+    static void pack(RYUW122_PayloadNumber &) {}
+    static void unpack(RYUW122_PayloadNumber &) {}
+};
+
+template <typename Field, typename... Rest>
+struct RYUW122_PayloadFields<Field, Rest...>
+{
+    static constexpr RYUW122_PayloadNumber::Wide values()
+    {
+        return RYUW122_PayloadNumber::multiply(RYUW122_PayloadFields<Rest...>::values(), Field::Range);
+    }
+
+    static void pack(RYUW122_PayloadNumber &number, typename Field::Value value, typename Rest::Value... rest)
+    {
+        RYUW122_PayloadFields<Rest...>::pack(number, rest...);
+        number.multiplyAdd(Field::Range, Field::toDigit(value));
+    }
+
+    static void unpack(RYUW122_PayloadNumber &number, typename Field::Value &value, typename Rest::Value &... rest)
+    {
+        value = Field::fromDigit(number.divide(Field::Range));
+        RYUW122_PayloadFields<Rest...>::unpack(number, rest...);
+    }
+};
+
+/*
+  Packs typed fields into the shortest payload a message can carry. The schema is a list of field
+  types; all fields together form one mixed-radix number (a field of Range values takes log2(Range)
+  bits, not a whole number of bits or bytes), which is written in base 92. 12 characters hold 78
+  bits instead of the 12 to 39 bits of decimal text.
+
+      typedef RYUW122_PayloadCodec<RYUW122_FixedField<250, 430, 100>,  // Battery 2.50..4.30 V
+                                   RYUW122_FixedField<-400, 850, 10>,  // Temperature -40.0..85.0 C
+                                   RYUW122_UIntField<16>,              // Sequence number
+                                   RYUW122_FlagField> Telemetry;       // Button pressed
+
+      char payload[Telemetry::BufferSize];                             // Telemetry::Length is 6
+      Telemetry::encode(payload, sizeof(payload), 3.71f, 22.5f, seq, pressed);
+      uwb.setTagResponseMessage(payload);
+      ...
+      Telemetry::decode(info, battery, temperature, seq, pressed);     // On the anchor
+
+  Length is a compile-time constant; a schema that does not fit into RYUW122_MAX_PAYLOAD characters
+  fails a static_assert. Values outside a field's range are clamped when encoding.
+*/
+template <typename... Fields>
+class RYUW122_PayloadCodec
+{
+    typedef RYUW122_PayloadFields<Fields...> Schema;
+
+public:
+    static_assert(sizeof...(Fields) > 0, "Schema has no fields");
+
+    static constexpr size_t Length = RYUW122_PayloadNumber::digits(Schema::values());
+    static constexpr size_t BufferSize = Length + 1;
+    static_assert(Length <= RYUW122_MAX_PAYLOAD, "Schema does not fit into one message");
+
+    // Writes Length characters and a null terminator
+    static bool encode(char *buffer, size_t bufferSize, typename Fields::Value... values)
+    {
+        if (!buffer || bufferSize < BufferSize) return false;
+
+        RYUW122_PayloadNumber number;
+        Schema::pack(number, values...);
+        for (size_t i = 0; i < Length; ++i)
+            buffer[i] = RYUW122_PayloadNumber::toChar(number.divide(RYUW122_PayloadNumber::Base));
+        buffer[Length] = '\0';
+        return number.isZero();
+    }
+
+    // Accepts payloads padded with spaces (padToMaxLength); false for a foreign or corrupted payload
+    static bool decode(const char *payload, size_t payloadLength, typename Fields::Value &... values)
+    {
+        if (!payload || payloadLength < Length) return false;
+        for (size_t i = Length; i < payloadLength; ++i)
+            if (payload[i] != ' ') return false;
+
+        RYUW122_PayloadNumber number;
+        for (size_t i = Length; i-- > 0;)
+        {
+            int8_t digit = RYUW122_PayloadNumber::fromChar(payload[i]);
+            if (digit < 0) return false;
+            number.multiplyAdd(RYUW122_PayloadNumber::Base, (uint8_t)digit);
+        }
+        Schema::unpack(number, values...);
+        return number.isZero(); // A rest means the number was larger than the schema allows
+    }
+
+    static bool decode(const RYUW122_MessageInfo &info, typename Fields::Value &... values)
+    {
+        return decode(info.payload, strnlen(info.payload, sizeof(info.payload)), values...);
+    }
+};
+
+#endif // RYUW122_PAYLOAD_H
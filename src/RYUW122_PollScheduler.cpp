@@ -0,0 +1,222 @@
+/*
+  RYUW122_PollScheduler.cpp - Motion-aware polling order for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_PollScheduler.h"
+
+#if RYUW122_HAS_ANCHOR
+
+RYUW122_PollScheduler::RYUW122_PollScheduler() {}
+
+RYUW122_PollScheduler::RYUW122_PollScheduler(const RYUW122_PollSchedulerConfig &config) : config(config) {}
+
+void RYUW122_PollScheduler::setConfig(const RYUW122_PollSchedulerConfig &config)
+{
+    this->config = config;
+}
+
+const RYUW122_PollSchedulerConfig &RYUW122_PollScheduler::getConfig() const
+{
+    return config;
+}
+
+bool RYUW122_PollScheduler::addTag(const RYUW122_Address &tag, unsigned long now)
+{
+    if (findTag(tag)) return true;
+    if (count >= RYUW122_SCHEDULER_MAX_TAGS) return false;
+
+    uint8_t *slot = slots.insert(tag);
+    if (!slot) return false;
+
+    uint8_t index = count++;
+    *slot = index;
+    tags[index] = Tag();
+    tags[index].address = tag;
+    tags[index].deadline = now; // Unknown tags are polled first
+    tags[index].interval = config.maxInterval;
+    tags[index].heapIndex = index;
+    heap[index] = index;
+    siftUp(index);
+    return true;
+}
+
+bool RYUW122_PollScheduler::removeTag(const RYUW122_Address &tag)
+{
+    uint8_t *slot = slots.find(tag);
+    if (!slot) return false;
+    uint8_t index = *slot;
+    slots.erase(tag);
+
+    // Replace the heap entry with the last one and restore the heap order
+    uint8_t position = tags[index].heapIndex;
+    swap(position, count - 1);
+    count--;
+    if (position < count)
+    {
+        siftDown(position);
+        siftUp(position);
+    }
+
+    // Keep the tags array dense: move the last tag into the freed place
+    if (index != count)
+    {
+        tags[index] = tags[count];
+        heap[tags[index].heapIndex] = index;
+        *slots.find(tags[index].address) = index;
+    }
+    return true;
+}
+
+uint8_t RYUW122_PollScheduler::getTagCount() const
+{
+    return count;
+}
+
+bool RYUW122_PollScheduler::next(RYUW122_Address &tag, unsigned long now)
+{
+    if (count == 0) return false;
+
+    Tag &first = tags[heap[0]];
+    if ((long)(now - first.deadline) < 0) return false;
+
+    tag = first.address;
+    reschedule(first, now + config.maxInterval); // Poll in flight, rescheduled again when it is reported
+    return true;
+}
+
+uint32_t RYUW122_PollScheduler::timeUntilNext(unsigned long now) const
+{
+    if (count == 0) return config.maxInterval;
+
+    long wait = (long)(tags[heap[0]].deadline - now);
+    return wait > 0 ? (uint32_t)wait : 0;
+}
+
+void RYUW122_PollScheduler::reportRange(const RYUW122_MessageInfo &info, unsigned long now)
+{
+    Tag *tag = findTag(RYUW122_Address::fromChars(info.address));
+    if (!tag) return;
+
+    if (!tag->hasRange)
+    {
+        tag->hasRange = true;
+        tag->referenceDistance = info.distance;
+        tag->referenceTime = now;
+    }
+    else
+    {
+        unsigned long elapsed = now - tag->referenceTime;
+        if (elapsed == 0) elapsed = 1;
+        uint16_t change = info.distance > tag->referenceDistance ? info.distance - tag->referenceDistance : tag->referenceDistance - info.distance;
+
+        if (change > config.noiseThreshold)
+        {
+            // Moved beyond the noise: speed over the whole movement, a faster tag is followed at once
+            float speed = change * 1000.0f / elapsed;
+            tag->speed = speed > tag->speed ? speed : tag->speed + (speed - tag->speed) * config.speedDecay;
+            tag->referenceDistance = info.distance;
+            tag->referenceTime = now;
+        }
+        else
+        {
+            // Staying within the noise for this long bounds the speed from above
+            float bound = config.noiseThreshold * 1000.0f / elapsed;
+            if (bound < tag->speed) tag->speed += (bound - tag->speed) * config.speedDecay;
+        }
+    }
+
+    uint32_t interval = tag->speed > 0.0f ? (uint32_t)(config.trackingError * 1000.0f / tag->speed) : config.maxInterval;
+    if (interval < config.minInterval) interval = config.minInterval;
+    if (interval > config.maxInterval) interval = config.maxInterval;
+    tag->interval = (uint16_t)interval;
+    tag->timeouts = 0;
+    reschedule(*tag, now + tag->interval);
+}
+
+void RYUW122_PollScheduler::reportTimeout(const RYUW122_Address &tag, unsigned long now)
+{
+    Tag *entry = findTag(tag);
+    if (!entry) return;
+
+    // Back off exponentially from the current interval, an unreachable tag does not eat the budget
+    if (entry->timeouts < 8) entry->timeouts++;
+    uint32_t interval = (uint32_t)entry->interval << entry->timeouts;
+    if (interval > config.maxInterval) interval = config.maxInterval;
+    reschedule(*entry, now + interval);
+}
+
+float RYUW122_PollScheduler::getSpeed(const RYUW122_Address &tag) const
+{
+    const Tag *entry = findTag(tag);
+    return entry ? entry->speed : 0.0f;
+}
+
+uint16_t RYUW122_PollScheduler::getInterval(const RYUW122_Address &tag) const
+{
+    const Tag *entry = findTag(tag);
+    return entry ? entry->interval : 0;
+}
+
+RYUW122_PollScheduler::Tag *RYUW122_PollScheduler::findTag(const RYUW122_Address &tag)
+{
+    uint8_t *slot = slots.find(tag);
+    return slot ? &tags[*slot] : nullptr;
+}
+
+const RYUW122_PollScheduler::Tag *RYUW122_PollScheduler::findTag(const RYUW122_Address &tag) const
+{
+    const uint8_t *slot = slots.find(tag);
+    return slot ? &tags[*slot] : nullptr;
+}
+
+void RYUW122_PollScheduler::reschedule(Tag &tag, unsigned long deadline)
+{
+    bool later = (long)(deadline - tag.deadline) > 0;
+    tag.deadline = deadline;
+    if (later) siftDown(tag.heapIndex);
+    else siftUp(tag.heapIndex);
+}
+
+void RYUW122_PollScheduler::swap(uint8_t a, uint8_t b)
+{
+    uint8_t index = heap[a];
+    heap[a] = heap[b];
+    heap[b] = index;
+    tags[heap[a]].heapIndex = a;
+    tags[heap[b]].heapIndex = b;
+}
+
+void RYUW122_PollScheduler::siftUp(uint8_t index)
+{
+    while (index > 0)
+    {
+        uint8_t parent = (index - 1) / 2;
+        if (!earlier(index, parent)) break;
+        swap(index, parent);
+        index = parent;
+    }
+}
+
+void RYUW122_PollScheduler::siftDown(uint8_t index)
+{
+    for (;;)
+    {
+        uint8_t smallest = index;
+        uint8_t left = 2 * index + 1;
+        uint8_t right = left + 1;
+        if (left < count && earlier(left, smallest)) smallest = left;
+        if (right < count && earlier(right, smallest)) smallest = right;
+        if (smallest == index) break;
+        swap(index, smallest);
+        index = smallest;
+    }
+}
+
+bool RYUW122_PollScheduler::earlier(uint8_t a, uint8_t b) const
+{
+    return (long)(tags[heap[a]].deadline - tags[heap[b]].deadline) < 0;
+}
+
+#endif // RYUW122_HAS_ANCHOR
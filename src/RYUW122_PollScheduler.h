@@ -0,0 +1,91 @@
+/*
+  RYUW122_PollScheduler.h - Motion-aware polling order for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_POLL_SCHEDULER_H
+#define RYUW122_POLL_SCHEDULER_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+#if RYUW122_HAS_ANCHOR
+
+#ifndef RYUW122_SCHEDULER_MAX_TAGS
+#define RYUW122_SCHEDULER_MAX_TAGS 16 // Tags scheduled at once (power of two)
+#endif
+
+struct RYUW122_PollSchedulerConfig
+{
+    uint16_t minInterval = 100;       // Shortest interval between polls of one tag [ms]
+    uint16_t maxInterval = 1000;      // Refresh floor: even a stationary tag is polled at least this often [ms]
+    uint16_t trackingError = 10;      // Distance a tag may move between two polls [cm]
+    uint16_t noiseThreshold = 8;      // Distance changes up to this are treated as ranging noise [cm]
+    float speedDecay = 0.25f;         // Weight of a lower speed sample; a higher one is taken immediately
+};
+
+/*
+  Decides which tag an anchor polls next. Every tag has a deadline; the tags are kept in a binary
+  min-heap ordered by deadline, so the next tag is found in O(1) and rescheduled in O(log n).
+
+  The radial speed of each tag is estimated from consecutive distances. A speed increase (the tag
+  started moving) is applied at once, a decrease is smoothed. The next deadline is
+  trackingError / speed after the range, clamped to [minInterval, maxInterval]. Moving tags get
+  more polls from the same air time, stationary tags are still refreshed every maxInterval, and
+  when the budget is exceeded the earliest deadline always wins, so no tag is starved.
+*/
+class RYUW122_PollScheduler
+{
+public:
+    RYUW122_PollScheduler();
+    explicit RYUW122_PollScheduler(const RYUW122_PollSchedulerConfig &config);
+
+    void setConfig(const RYUW122_PollSchedulerConfig &config);
+    const RYUW122_PollSchedulerConfig &getConfig() const;
+
+    bool addTag(const RYUW122_Address &tag, unsigned long now);
+    bool removeTag(const RYUW122_Address &tag);
+    uint8_t getTagCount() const;
+
+    // Tag with the earliest deadline when it is due; the tag is not returned again until it is reported
+    bool next(RYUW122_Address &tag, unsigned long now);
+    uint32_t timeUntilNext(unsigned long now) const;
+
+    void reportRange(const RYUW122_MessageInfo &info, unsigned long now);
+    void reportTimeout(const RYUW122_Address &tag, unsigned long now);
+
+    float getSpeed(const RYUW122_Address &tag) const;      // [cm/s]
+    uint16_t getInterval(const RYUW122_Address &tag) const; // [ms], 0 for an unknown tag
+
+private:
+    struct Tag
+    {
+        RYUW122_Address address;
+        unsigned long deadline = 0;
+        unsigned long referenceTime = 0;      // Time of the last range that moved beyond the noise threshold
+        uint16_t referenceDistance = 0;
+        uint16_t interval = 0;
+        float speed = 0.0f;
+        uint8_t heapIndex = 0;
+        uint8_t timeouts = 0;
+        bool hasRange = false;
+    };
+
+    RYUW122_PollSchedulerConfig config;
+    Tag tags[RYUW122_SCHEDULER_MAX_TAGS];
+    RYUW122_AddressMap<uint8_t, RYUW122_SCHEDULER_MAX_TAGS> slots; // Address -> index into tags
+    uint8_t heap[RYUW122_SCHEDULER_MAX_TAGS];                       // Indices into tags, earliest deadline first
+    uint8_t count = 0;
+
+    Tag *findTag(const RYUW122_Address &tag);
+    const Tag *findTag(const RYUW122_Address &tag) const;
+    void reschedule(Tag &tag, unsigned long deadline);
+    void swap(uint8_t a, uint8_t b);
+    void siftUp(uint8_t index);
+    void siftDown(uint8_t index);
+    bool earlier(uint8_t a, uint8_t b) const;
+};
+
+#endif // RYUW122_HAS_ANCHOR
+
+#endif // RYUW122_POLL_SCHEDULER_H
@@ -0,0 +1,157 @@
+/*
+  RYUW122_Power.cpp - Fast sleep / wake cycling for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_Power.h"
+
+RYUW122_PowerManager::RYUW122_PowerManager(RYUW122_UWB &uwb) : uwb(uwb)
+{
+#if RYUW122_HAS_TAG
+    responseMessage[0] = '\0';
+#endif
+}
+
+bool RYUW122_PowerManager::begin()
+{
+    state = POWER_ACTIVE;
+    return uwb.getMode(mode);
+}
+
+void RYUW122_PowerManager::setWakeTimeout(uint16_t timeout)
+{
+    wakeTimeout = timeout;
+}
+
+bool RYUW122_PowerManager::setMode(RYUW122_Mode mode)
+{
+    if (mode != MODE_TAG && mode != MODE_ANCHOR) return false;
+    if (state != POWER_ACTIVE) return false;
+    if (mode == this->mode) return true;
+
+    flashWrites++;
+    if (!uwb.setMode(mode)) return false;
+    this->mode = mode;
+    return restoreVolatileState();
+}
+
+RYUW122_Mode RYUW122_PowerManager::getMode() const
+{
+    return mode;
+}
+
+#if RYUW122_HAS_TAG
+bool RYUW122_PowerManager::setResponseMessage(const char *message, size_t messageLen, bool padToMaxLength)
+{
+    if (!message) return false;
+    if (messageLen == 0) messageLen = strnlen(message, RYUW122_MAX_PAYLOAD + 1);
+    if (messageLen == 0 || messageLen > RYUW122_MAX_PAYLOAD) return false;
+
+    memcpy(responseMessage, message, messageLen);
+    responseMessage[messageLen] = '\0';
+    responseMessageLen = messageLen;
+    responsePadToMaxLength = padToMaxLength;
+
+    if (state != POWER_ACTIVE) return true; // Sent on wake
+    return restoreVolatileState();
+}
+#endif
+
+bool RYUW122_PowerManager::sleep()
+{
+    if (state == POWER_RESET_SLEEP || state == POWER_MODE_SLEEP) return true;
+
+    unsigned long startTime = micros();
+    int16_t resetPin = uwb.getResetPin();
+    if (resetPin != -1)
+    {
+        digitalWrite(resetPin, LOW); // Held until wake(), the module boots from its stored configuration
+        state = POWER_RESET_SLEEP;
+    }
+    else
+    {
+        if (mode != MODE_TAG && mode != MODE_ANCHOR) return false; // Nothing to return to
+        flashWrites++;
+        if (!uwb.setMode(MODE_SLEEP)) return false;
+        state = POWER_MODE_SLEEP;
+    }
+
+    lastSleepTime = micros() - startTime;
+    sleepCount++;
+    return true;
+}
+
+bool RYUW122_PowerManager::wake()
+{
+    if (state == POWER_ACTIVE) return true;
+
+    unsigned long startTime = micros();
+    bool result;
+    if (state == POWER_RESET_SLEEP || (state == POWER_WAKE_FAILED && uwb.getResetPin() != -1))
+    {
+        digitalWrite(uwb.getResetPin(), HIGH);
+        // READY ends the wait as soon as the module has booted, the probe covers a missed line
+        result = uwb.waitReady(wakeTimeout) || uwb.isConnected();
+    }
+    else
+    {
+        uwb.isConnected(); // First command only wakes the UART, its response is not reliable
+        flashWrites++;
+        result = uwb.setMode(mode);
+    }
+
+    if (result) result = restoreVolatileState();
+    state = result ? POWER_ACTIVE : POWER_WAKE_FAILED;
+
+    lastWakeTime = micros() - startTime;
+    if (lastWakeTime > maxWakeTime) maxWakeTime = lastWakeTime;
+    return result;
+}
+
+RYUW122_PowerState RYUW122_PowerManager::getState() const
+{
+    return state;
+}
+
+bool RYUW122_PowerManager::isSleeping() const
+{
+    return state == POWER_RESET_SLEEP || state == POWER_MODE_SLEEP;
+}
+
+uint32_t RYUW122_PowerManager::getLastSleepTime() const
+{
+    return lastSleepTime;
+}
+
+uint32_t RYUW122_PowerManager::getLastWakeTime() const
+{
+    return lastWakeTime;
+}
+
+uint32_t RYUW122_PowerManager::getMaxWakeTime() const
+{
+    return maxWakeTime;
+}
+
+uint32_t RYUW122_PowerManager::getSleepCount() const
+{
+    return sleepCount;
+}
+
+uint32_t RYUW122_PowerManager::getFlashWrites() const
+{
+    return flashWrites;
+}
+
+bool RYUW122_PowerManager::restoreVolatileState()
+{
+#if RYUW122_HAS_TAG
+    // The tag response message lives in RAM of the module and is lost on every reset
+    if (mode == MODE_TAG && responseMessageLen != 0)
+    {
+        return uwb.setTagResponseMessage(responseMessage, responseMessageLen, false, responsePadToMaxLength);
+    }
+#endif
+    return true;
+}
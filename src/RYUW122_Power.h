@@ -0,0 +1,77 @@
+/*
+  RYUW122_Power.h - Fast sleep / wake cycling for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_POWER_H
+#define RYUW122_POWER_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+enum RYUW122_PowerState : int8_t
+{
+    POWER_MODE_SLEEP  =  2,  // Module is in AT+MODE=2 (no reset pin), every transition writes flash
+    POWER_RESET_SLEEP =  1,  // Module is held in reset, nothing was written
+    POWER_ACTIVE      =  0,  // Module is running
+    POWER_WAKE_FAILED = -1   // Module did not answer after the last wake()
+};
+
+/*
+  Puts the module to sleep and wakes it without the flash writes of setMode(MODE_SLEEP).
+
+  With a reset pin (passed to RYUW122_UWB::begin()) sleep() holds the module in reset and wake()
+  releases it and returns as soon as the module prints READY; the operating mode stored in flash
+  is kept, so only volatile state has to be restored: the tag response message set through this
+  class. Without a reset pin AT+MODE=2 is used as before and the flash writes are counted.
+
+  The operating mode is read once in begin() and tracked in memory afterwards; setMode() writes
+  only when the mode really changes. Module commands must not be issued while the module sleeps.
+*/
+class RYUW122_PowerManager
+{
+public:
+    explicit RYUW122_PowerManager(RYUW122_UWB &uwb);
+
+    bool begin();                                    // Reads the operating mode of the running module
+    void setWakeTimeout(uint16_t timeout);           // Longest wait for READY [ms]
+
+    bool setMode(RYUW122_Mode mode);                 // MODE_TAG or MODE_ANCHOR, writes flash only on a change
+    RYUW122_Mode getMode() const;
+#if RYUW122_HAS_TAG
+    bool setResponseMessage(const char *message, size_t messageLen = 0, bool padToMaxLength = false); // Sent now and after every wake
+#endif
+
+    bool sleep();
+    bool wake();
+    RYUW122_PowerState getState() const;
+    bool isSleeping() const;
+
+    uint32_t getLastSleepTime() const;               // Duration of the last sleep transition [us]
+    uint32_t getLastWakeTime() const;                // Duration of the last wake transition, READY and restore included [us]
+    uint32_t getMaxWakeTime() const;                 // [us]
+    uint32_t getSleepCount() const;
+    uint32_t getFlashWrites() const;
+
+private:
+    RYUW122_UWB &uwb;
+    RYUW122_PowerState state = POWER_ACTIVE;
+    RYUW122_Mode mode = MODE_UNKNOWN;
+    uint16_t wakeTimeout = 1000;
+
+#if RYUW122_HAS_TAG
+    char responseMessage[RYUW122_MAX_PAYLOAD + 1];
+    uint8_t responseMessageLen = 0;
+    bool responsePadToMaxLength = false;
+#endif
+
+    uint32_t lastSleepTime = 0;
+    uint32_t lastWakeTime = 0;
+    uint32_t maxWakeTime = 0;
+    uint32_t sleepCount = 0;
+    uint32_t flashWrites = 0;
+
+    bool restoreVolatileState();
+};
+
+#endif // RYUW122_POWER_H
@@ -0,0 +1,129 @@
+/*
+  RYUW122_RangeStats.cpp - Per-tag ranging quality statistics for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_RangeStats.h"
+
+#if RYUW122_HAS_ANCHOR
+
+static const float SmoothingGain = 1.0f / 16.0f;
+
+void RYUW122_RangeStats::report(const RYUW122_Address &tag, RYUW122_MessageState state, const RYUW122_MessageInfo &info, unsigned long now)
+{
+    if (state == MESSAGE_RECEIVED) reportRange(info, now);
+    else if (state != MESSAGE_WAITING && state != MESSAGE_NOT_REQUESTED) reportFailure(tag, state);
+}
+
+void RYUW122_RangeStats::reportRange(const RYUW122_MessageInfo &info, unsigned long now)
+{
+    Entry *tag = entry(RYUW122_Address::fromChars(info.address));
+    if (!tag) return;
+
+    tag->successes++;
+
+    // Welford: numerically stable mean and variance in one pass
+    double delta = info.distance - tag->mean;
+    tag->mean += delta / tag->successes;
+    tag->m2 += delta * (info.distance - tag->mean);
+    tag->lastDistance = info.distance;
+
+    if (tag->successes > 1)
+    {
+        uint32_t interval = now - tag->lastRangeTime;
+        if (!tag->hasInterval)
+        {
+            tag->interval = interval;
+            tag->hasInterval = true;
+        }
+        else
+        {
+            // Jitter as in RFC 3550: smoothed difference between consecutive intervals
+            float change = (float)interval - (float)tag->lastInterval;
+            tag->jitter += ((change < 0 ? -change : change) - tag->jitter) * SmoothingGain;
+            tag->interval += ((float)interval - tag->interval) * SmoothingGain;
+        }
+        tag->lastInterval = interval;
+    }
+    tag->lastRangeTime = now;
+}
+
+void RYUW122_RangeStats::reportFailure(const RYUW122_Address &tag, RYUW122_MessageState state)
+{
+    Entry *stats = entry(tag);
+    if (!stats) return;
+
+    if (state == MESSAGE_TIMEOUT) stats->timeouts++;
+    else stats->errors++;
+}
+
+bool RYUW122_RangeStats::getStats(const RYUW122_Address &tag, RYUW122_TagStats &stats, unsigned long now) const
+{
+    const Entry *found = entries.find(tag);
+    if (!found) return false;
+    snapshot(tag, *found, stats, now);
+    return true;
+}
+
+bool RYUW122_RangeStats::next(size_t &cursor, RYUW122_TagStats &stats, unsigned long now) const
+{
+    while (cursor < entries.capacity())
+    {
+        size_t slot = cursor++;
+        if (entries.occupied(slot))
+        {
+            snapshot(entries.keyAt(slot), entries.valueAt(slot), stats, now);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RYUW122_RangeStats::remove(const RYUW122_Address &tag)
+{
+    return entries.erase(tag);
+}
+
+void RYUW122_RangeStats::clear()
+{
+    entries.clear();
+    droppedCount = 0;
+}
+
+uint8_t RYUW122_RangeStats::getTagCount() const
+{
+    return entries.size();
+}
+
+uint32_t RYUW122_RangeStats::getDroppedCount() const
+{
+    return droppedCount;
+}
+
+RYUW122_RangeStats::Entry *RYUW122_RangeStats::entry(const RYUW122_Address &tag)
+{
+    if (!tag.isValid()) return nullptr;
+    Entry *found = entries.insert(tag);
+    if (!found) droppedCount++;
+    return found;
+}
+
+void RYUW122_RangeStats::snapshot(const RYUW122_Address &address, const Entry &entry, RYUW122_TagStats &stats, unsigned long now)
+{
+    stats.address = address;
+    stats.successes = entry.successes;
+    stats.timeouts = entry.timeouts;
+    stats.errors = entry.errors;
+    stats.polls = entry.successes + entry.timeouts + entry.errors;
+    stats.successRatio = stats.polls ? (float)entry.successes / stats.polls : 0.0f;
+    stats.timeoutRatio = stats.polls ? (float)entry.timeouts / stats.polls : 0.0f;
+    stats.distanceMean = (float)entry.mean;
+    stats.distanceVariance = entry.successes > 1 ? (float)(entry.m2 / (entry.successes - 1)) : 0.0f;
+    stats.lastDistance = entry.lastDistance;
+    stats.interval = entry.interval;
+    stats.jitter = entry.jitter;
+    stats.timeSinceLastRange = entry.successes ? (uint32_t)(now - entry.lastRangeTime) : UINT32_MAX;
+}
+
+#endif // RYUW122_HAS_ANCHOR
@@ -0,0 +1,93 @@
+/*
+  RYUW122_RangeStats.h - Per-tag ranging quality statistics for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_RANGE_STATS_H
+#define RYUW122_RANGE_STATS_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+#if RYUW122_HAS_ANCHOR
+
+#ifndef RYUW122_STATS_MAX_TAGS
+#define RYUW122_STATS_MAX_TAGS 16 // Tags tracked at once (power of two)
+#endif
+
+// Snapshot of one tag, derived from the accumulators when it is read
+struct RYUW122_TagStats
+{
+    RYUW122_Address address;
+    uint32_t polls = 0;                // Outcomes reported: successes + timeouts + errors
+    uint32_t successes = 0;
+    uint32_t timeouts = 0;
+    uint32_t errors = 0;               // Parse errors and +ERR responses
+    float successRatio = 0.0f;
+    float timeoutRatio = 0.0f;
+    float distanceMean = 0.0f;         // [cm]
+    float distanceVariance = 0.0f;     // Sample variance [cm^2]
+    uint16_t lastDistance = 0;         // [cm]
+    float interval = 0.0f;             // Smoothed time between good ranges [ms]
+    float jitter = 0.0f;               // Smoothed difference of consecutive intervals (RFC 3550) [ms]
+    uint32_t timeSinceLastRange = 0;   // [ms], UINT32_MAX before the first good range
+};
+
+/*
+  Always-on health metrics for every polled tag without keeping any samples. Each outcome of
+  receiveMessageAsyncAnchor() updates the tag's accumulators in constant time: counters, Welford's
+  running mean and variance of the distance, and exponentially smoothed interval and jitter
+  (gain 1/16). Tags are kept in a fixed-capacity address map; a tag that does not fit is counted
+  by getDroppedCount().
+
+  The Welford accumulators are double. On AVR double is the same 32-bit type as float, so after
+  roughly 10^5 ranges of one tag the mean stops following slow drifts and the variance loses
+  precision; remove() the tag to restart its statistics when that matters.
+
+  Iterate with a cursor:
+
+      RYUW122_TagStats tag;
+      for (size_t cursor = 0; stats.next(cursor, tag, millis());) { ... }
+*/
+class RYUW122_RangeStats
+{
+public:
+    // Dispatches on the state; MESSAGE_WAITING and MESSAGE_NOT_REQUESTED are ignored
+    void report(const RYUW122_Address &tag, RYUW122_MessageState state, const RYUW122_MessageInfo &info, unsigned long now);
+    void reportRange(const RYUW122_MessageInfo &info, unsigned long now);
+    void reportFailure(const RYUW122_Address &tag, RYUW122_MessageState state);
+
+    bool getStats(const RYUW122_Address &tag, RYUW122_TagStats &stats, unsigned long now) const;
+    bool next(size_t &cursor, RYUW122_TagStats &stats, unsigned long now) const; // false after the last tag
+
+    bool remove(const RYUW122_Address &tag);
+    void clear();
+    uint8_t getTagCount() const;
+    uint32_t getDroppedCount() const;
+
+private:
+    struct Entry
+    {
+        uint32_t successes = 0;
+        uint32_t timeouts = 0;
+        uint32_t errors = 0;
+        double mean = 0.0;             // Welford
+        double m2 = 0.0;
+        float interval = 0.0f;
+        float jitter = 0.0f;
+        unsigned long lastRangeTime = 0;
+        uint32_t lastInterval = 0;
+        uint16_t lastDistance = 0;
+        bool hasInterval = false;
+    };
+
+    RYUW122_AddressMap<Entry, RYUW122_STATS_MAX_TAGS> entries;
+    uint32_t droppedCount = 0;
+
+    Entry *entry(const RYUW122_Address &tag);
+    static void snapshot(const RYUW122_Address &address, const Entry &entry, RYUW122_TagStats &stats, unsigned long now);
+};
+
+#endif // RYUW122_HAS_ANCHOR
+
+#endif // RYUW122_RANGE_STATS_H
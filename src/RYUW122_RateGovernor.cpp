@@ -0,0 +1,160 @@
+/*
+  RYUW122_RateGovernor.cpp - Polling rate limiter for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_RateGovernor.h"
+
+RYUW122_RateGovernor::RYUW122_RateGovernor()
+{
+    global.interval = config.globalInterval;
+}
+
+RYUW122_RateGovernor::RYUW122_RateGovernor(const RYUW122_RateGovernorConfig &config)
+{
+    setConfig(config);
+}
+
+void RYUW122_RateGovernor::setConfig(const RYUW122_RateGovernorConfig &config)
+{
+    this->config = config;
+    global.interval = config.globalInterval;
+    for (size_t i = 0; i < tags.capacity(); ++i)
+    {
+        if (tags.occupied(i)) tags.valueAt(i).interval = config.tagInterval;
+    }
+}
+
+const RYUW122_RateGovernorConfig &RYUW122_RateGovernor::getConfig() const
+{
+    return config;
+}
+
+bool RYUW122_RateGovernor::acquire(const RYUW122_Address &address, unsigned long now)
+{
+    if (timeUntilAllowed(address, now) != 0)
+    {
+        throttledCount++;
+        return false;
+    }
+
+    consume(global, now);
+    Bucket *tag = insertTag(address, now);
+    if (tag) consume(*tag, now);
+    return true;
+}
+
+uint32_t RYUW122_RateGovernor::timeUntilAllowed(const RYUW122_Address &address, unsigned long now)
+{
+    uint32_t wait = bucketWait(global, config.globalMinInterval, config.globalBurst, now);
+
+    const Bucket *tag = tags.find(address);
+    if (tag)
+    {
+        uint32_t tagWait = bucketWait(*tag, config.tagMinInterval, config.tagBurst, now);
+        if (tagWait > wait) wait = tagWait;
+    }
+    return wait;
+}
+
+void RYUW122_RateGovernor::reportSuccess(const RYUW122_Address &address)
+{
+    relax(global, config.globalInterval);
+
+    Bucket *tag = tags.find(address);
+    if (tag) relax(*tag, config.tagInterval);
+}
+
+void RYUW122_RateGovernor::reportTimeout(const RYUW122_Address &address)
+{
+    timeoutCount++;
+    stretch(global);
+
+    Bucket *tag = tags.find(address);
+    if (tag) stretch(*tag);
+}
+
+uint16_t RYUW122_RateGovernor::getGlobalInterval() const
+{
+    return global.interval;
+}
+
+uint32_t RYUW122_RateGovernor::getThrottledCount() const
+{
+    return throttledCount;
+}
+
+uint32_t RYUW122_RateGovernor::getTimeoutCount() const
+{
+    return timeoutCount;
+}
+
+RYUW122_RateGovernor::Bucket *RYUW122_RateGovernor::insertTag(const RYUW122_Address &address, unsigned long now)
+{
+    Bucket *tag = tags.find(address);
+    if (tag) return tag;
+
+    if (tags.full())
+    {
+        // Replace the least recently polled tag
+        size_t oldest = 0;
+        for (size_t i = 1; i < tags.capacity(); ++i)
+        {
+            if ((long)(tags.valueAt(i).lastSend - tags.valueAt(oldest).lastSend) < 0) oldest = i;
+        }
+        tags.erase(tags.keyAt(oldest));
+    }
+
+    tag = tags.insert(address);
+    if (!tag) return nullptr; // Invalid (empty) address
+    tag->interval = config.tagInterval;
+    tag->lastSend = now;
+    return tag;
+}
+
+uint32_t RYUW122_RateGovernor::bucketWait(const Bucket &bucket, uint16_t minInterval, uint8_t burst, unsigned long now) const
+{
+    if (!bucket.used) return 0;
+
+    long wait = 0;
+
+    // Hard minimum interval, applies even when the bucket is full
+    long sinceLast = (long)(now - bucket.lastSend);
+    if (sinceLast < (long)minInterval) wait = minInterval - sinceLast;
+
+    // GCRA: sending is allowed while the theoretical arrival time is at most (burst - 1) intervals ahead
+    long tolerance = (long)(burst > 0 ? burst - 1 : 0) * bucket.interval;
+    long ahead = (long)(bucket.theoreticalArrival - now) - tolerance;
+    if (ahead > wait) wait = ahead;
+
+    return (uint32_t)wait;
+}
+
+void RYUW122_RateGovernor::consume(Bucket &bucket, unsigned long now)
+{
+    if (!bucket.used || (long)(bucket.theoreticalArrival - now) < 0)
+    {
+        bucket.theoreticalArrival = now;
+    }
+    bucket.theoreticalArrival += bucket.interval;
+    bucket.lastSend = now;
+    bucket.used = true;
+}
+
+void RYUW122_RateGovernor::stretch(Bucket &bucket)
+{
+    uint32_t interval = bucket.interval + bucket.interval / 2 + 1;
+    bucket.interval = interval > config.maxInterval ? config.maxInterval : (uint16_t)interval;
+}
+
+void RYUW122_RateGovernor::relax(Bucket &bucket, uint16_t baseInterval)
+{
+    if (bucket.interval <= baseInterval)
+    {
+        bucket.interval = baseInterval;
+        return;
+    }
+    uint16_t step = (bucket.interval - baseInterval) / 8;
+    bucket.interval -= step > 0 ? step : 1;
+}
@@ -0,0 +1,72 @@
+/*
+  RYUW122_RateGovernor.h - Polling rate limiter for RYUW122_UWB anchors.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_RATE_GOVERNOR_H
+#define RYUW122_RATE_GOVERNOR_H
+
+#include <Arduino.h>
+#include "RYUW122_Address.h"
+
+#ifndef RYUW122_GOVERNOR_MAX_TAGS
+#define RYUW122_GOVERNOR_MAX_TAGS 8 // Tags tracked at once (power of two), the least recently polled one is replaced
+#endif
+
+struct RYUW122_RateGovernorConfig
+{
+    uint16_t globalInterval = 66;      // Average interval between any two polls [ms], ~15 Hz below the ~16 Hz limit
+    uint16_t globalMinInterval = 50;   // Hard minimum between any two polls, also inside a burst [ms]
+    uint8_t globalBurst = 3;           // Polls allowed back-to-back after an idle period
+    uint16_t tagInterval = 100;        // Average interval between polls of the same tag [ms]
+    uint16_t tagMinInterval = 80;      // Hard minimum between polls of the same tag [ms]
+    uint8_t tagBurst = 2;              // Polls of one tag allowed back-to-back after an idle period
+    uint16_t maxInterval = 2000;       // Upper limit of the intervals stretched after timeouts [ms]
+};
+
+/*
+  Limits how often an anchor polls tags. Both limits are token buckets (implemented as GCRA,
+  one timestamp per bucket) with an additional hard minimum interval. Timeouts stretch the
+  interval of the global and the tag bucket by 50 %, successes shrink it back gradually.
+*/
+class RYUW122_RateGovernor
+{
+public:
+    RYUW122_RateGovernor();
+    explicit RYUW122_RateGovernor(const RYUW122_RateGovernorConfig &config);
+
+    void setConfig(const RYUW122_RateGovernorConfig &config);
+    const RYUW122_RateGovernorConfig &getConfig() const;
+
+    bool acquire(const RYUW122_Address &address, unsigned long now);
+    uint32_t timeUntilAllowed(const RYUW122_Address &address, unsigned long now);
+    void reportSuccess(const RYUW122_Address &address);
+    void reportTimeout(const RYUW122_Address &address);
+
+    uint16_t getGlobalInterval() const;
+    uint32_t getThrottledCount() const;
+    uint32_t getTimeoutCount() const;
+
+private:
+    struct Bucket
+    {
+        unsigned long theoreticalArrival = 0; // Time when the bucket is completely refilled
+        unsigned long lastSend = 0;
+        uint16_t interval = 0;                // Current, possibly stretched, average interval [ms]
+        bool used = false;
+    };
+
+    RYUW122_RateGovernorConfig config;
+    Bucket global;
+    RYUW122_AddressMap<Bucket, RYUW122_GOVERNOR_MAX_TAGS> tags;
+    uint32_t throttledCount = 0;
+    uint32_t timeoutCount = 0;
+
+    Bucket *insertTag(const RYUW122_Address &address, unsigned long now);
+    uint32_t bucketWait(const Bucket &bucket, uint16_t minInterval, uint8_t burst, unsigned long now) const;
+    void consume(Bucket &bucket, unsigned long now);
+    void stretch(Bucket &bucket);
+    void relax(Bucket &bucket, uint16_t baseInterval);
+};
+
+#endif // RYUW122_RATE_GOVERNOR_H
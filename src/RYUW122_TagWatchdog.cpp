@@ -0,0 +1,217 @@
+/*
+  RYUW122_TagWatchdog.cpp - Wedged tag detection and recovery for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#include "Arduino.h"
+#include "RYUW122_TagWatchdog.h"
+
+#if RYUW122_HAS_TAG
+
+RYUW122_TagWatchdog::RYUW122_TagWatchdog(RYUW122_UWB &uwb) : uwb(uwb)
+{
+    responseMessage[0] = '\0';
+    pendingAddress[0] = '\0';
+}
+
+void RYUW122_TagWatchdog::setTrafficTimeout(uint32_t timeout)
+{
+    trafficTimeout = timeout;
+}
+
+void RYUW122_TagWatchdog::setHeartbeatInterval(uint32_t interval)
+{
+    heartbeatInterval = interval;
+}
+
+void RYUW122_TagWatchdog::setFlashWriteBudget(uint32_t budget)
+{
+    flashWriteBudget = budget;
+}
+
+bool RYUW122_TagWatchdog::setResponseMessage(const char *message, size_t messageLen, bool padToMaxLength)
+{
+    if (!message) return false;
+    if (messageLen == 0) messageLen = strnlen(message, RYUW122_MAX_PAYLOAD + 1);
+    if (messageLen == 0 || messageLen > RYUW122_MAX_PAYLOAD) return false;
+
+    memcpy(responseMessage, message, messageLen);
+    responseMessage[messageLen] = '\0';
+    responseMessageLen = messageLen;
+    responsePadToMaxLength = padToMaxLength;
+
+    return restoreResponseMessage();
+}
+
+bool RYUW122_TagWatchdog::setPendingAddress(const char *address, size_t len)
+{
+    if (!address) return false;
+    if (len == 0) len = strnlen(address, 9);
+    if (len > 8) return false;
+
+    memcpy(pendingAddress, address, len);
+    pendingAddress[len] = '\0';
+    pendingFlags |= PENDING_ADDRESS;
+    return true;
+}
+
+void RYUW122_TagWatchdog::setPendingTagParameters(uint16_t enableTime, uint16_t disableTime)
+{
+    pendingEnableTime = enableTime;
+    pendingDisableTime = disableTime;
+    pendingFlags |= PENDING_TAG_PARAMS;
+}
+
+void RYUW122_TagWatchdog::setPendingCalibrationDistance(int8_t distance)
+{
+    pendingCalibration = distance;
+    pendingFlags |= PENDING_CALIBRATION;
+}
+
+bool RYUW122_TagWatchdog::hasPendingConfiguration() const
+{
+    return pendingFlags != 0;
+}
+
+RYUW122_MessageState RYUW122_TagWatchdog::receive(RYUW122_MessageInfo &info)
+{
+    RYUW122_MessageState state = uwb.receiveMessageAsyncTag(info);
+    if (state == MESSAGE_RECEIVED || state == MESSAGE_PARSE_ERROR)
+    {
+        lastTrafficTime = millis(); // Any +TAG_RCV line proves the UART is alive
+        return state;
+    }
+
+    update();
+    return state;
+}
+
+RYUW122_WatchdogState RYUW122_TagWatchdog::update()
+{
+    unsigned long now = millis();
+    if (lastTrafficTime == 0) lastTrafficTime = now;
+    if (lastProbeTime == 0) lastProbeTime = now;
+
+    bool silent = trafficTimeout != 0 && now - lastTrafficTime >= trafficTimeout;
+    bool heartbeatDue = heartbeatInterval != 0 && now - lastProbeTime >= heartbeatInterval;
+    if (!silent && !heartbeatDue) return WATCHDOG_HEALTHY;
+
+    lastProbeTime = now;
+    if (uwb.isConnected())
+    {
+        // Module answers, the anchor is just not polling. Wait another full timeout before probing again.
+        lastTrafficTime = millis();
+        return WATCHDOG_HEALTHY;
+    }
+
+    return recover();
+}
+
+RYUW122_WatchdogState RYUW122_TagWatchdog::recover()
+{
+    unsigned long startTime = millis();
+
+    uwb.reset();
+
+    // Switching to anchor mode and back wakes a wedged UART; pending parameters are written in between
+    bool budgetExhausted = false;
+    if (flashWrites + 2 > flashWriteBudget)
+    {
+        budgetExhausted = true; // Only the reset is possible, configuration stays pending
+    }
+    else
+    {
+        flashWrites++;
+        bool result = uwb.setMode(MODE_ANCHOR);
+        if (result && pendingFlags != 0)
+        {
+            if (flashWrites + pendingFlashWrites() + 1 > flashWriteBudget) budgetExhausted = true; // Keep the configuration pending
+            else result = applyPendingConfiguration();
+        }
+
+        flashWrites++;
+        result = uwb.setMode(MODE_TAG) && result;
+        if (!result) return finishRecovery(startTime, WATCHDOG_RECOVERY_FAILED);
+    }
+
+    if (!restoreResponseMessage() || !uwb.isConnected())
+    {
+        return finishRecovery(startTime, WATCHDOG_RECOVERY_FAILED);
+    }
+
+    return finishRecovery(startTime, budgetExhausted ? WATCHDOG_BUDGET_EXHAUSTED : WATCHDOG_RECOVERED);
+}
+
+uint32_t RYUW122_TagWatchdog::getRecoveryCount() const
+{
+    return recoveryCount;
+}
+
+uint32_t RYUW122_TagWatchdog::getLastRecoveryTime() const
+{
+    return lastRecoveryTime;
+}
+
+uint32_t RYUW122_TagWatchdog::getMaxRecoveryTime() const
+{
+    return maxRecoveryTime;
+}
+
+uint32_t RYUW122_TagWatchdog::getFlashWrites() const
+{
+    return flashWrites;
+}
+
+uint32_t RYUW122_TagWatchdog::getFlashWriteBudget() const
+{
+    return flashWriteBudget;
+}
+
+uint8_t RYUW122_TagWatchdog::pendingFlashWrites() const
+{
+    uint8_t writes = 0; // Parameters only, the mode cycle is counted by recover()
+    if (pendingFlags & PENDING_ADDRESS) writes++;
+    if (pendingFlags & PENDING_TAG_PARAMS) writes++;
+    if (pendingFlags & PENDING_CALIBRATION) writes++;
+    return writes;
+}
+
+bool RYUW122_TagWatchdog::applyPendingConfiguration()
+{
+    // Each parameter is cleared only when it was stored, failed ones are retried on the next recovery
+    if (pendingFlags & PENDING_ADDRESS)
+    {
+        flashWrites++;
+        if (uwb.setAddress(pendingAddress)) pendingFlags &= ~PENDING_ADDRESS;
+    }
+    if (pendingFlags & PENDING_TAG_PARAMS)
+    {
+        flashWrites++;
+        if (uwb.setTagParameters(pendingEnableTime, pendingDisableTime)) pendingFlags &= ~PENDING_TAG_PARAMS;
+    }
+    if (pendingFlags & PENDING_CALIBRATION)
+    {
+        flashWrites++;
+        if (uwb.setCalibrationDistance(pendingCalibration)) pendingFlags &= ~PENDING_CALIBRATION;
+    }
+    return pendingFlags == 0;
+}
+
+bool RYUW122_TagWatchdog::restoreResponseMessage()
+{
+    if (responseMessageLen == 0) return true; // Nothing to restore, module replies with an empty message
+    return uwb.setTagResponseMessage(responseMessage, responseMessageLen, false, responsePadToMaxLength);
+}
+
+RYUW122_WatchdogState RYUW122_TagWatchdog::finishRecovery(unsigned long startTime, RYUW122_WatchdogState state)
+{
+    lastRecoveryTime = millis() - startTime;
+    if (lastRecoveryTime > maxRecoveryTime) maxRecoveryTime = lastRecoveryTime;
+    recoveryCount++;
+
+    lastTrafficTime = millis();
+    lastProbeTime = lastTrafficTime;
+    return state;
+}
+
+#endif // RYUW122_HAS_TAG
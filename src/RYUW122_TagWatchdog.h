@@ -0,0 +1,98 @@
+/*
+  RYUW122_TagWatchdog.h - Wedged tag detection and recovery for RYUW122_UWB library.
+  Released into the public domain.
+*/
+
+#ifndef RYUW122_TAG_WATCHDOG_H
+#define RYUW122_TAG_WATCHDOG_H
+
+#include <Arduino.h>
+#include "RYUW122_UWB.h"
+
+#if RYUW122_HAS_TAG
+
+enum RYUW122_WatchdogState : int8_t
+{
+    WATCHDOG_HEALTHY          =  1,  // Module responds or tag traffic is flowing
+    WATCHDOG_RECOVERED        =  2,  // Module was wedged and the recovery succeeded
+    WATCHDOG_RECOVERY_FAILED  = -1,  // Module was wedged and still does not respond
+    WATCHDOG_BUDGET_EXHAUSTED = -2   // Recovery needs flash writes, but the wear budget is used up
+};
+
+/*
+  Watches a module in tag mode and recovers it when the UART gets blocked by rapid polling.
+
+  The tag is considered suspicious when no +TAG_RCV arrived within the traffic timeout or when
+  the periodic heartbeat is due. It is then probed with "AT"; no answer means the UART is wedged
+  and the recovery from the README is executed:
+    - hardware reset (reset pin passed to begin() is required for a reliable recovery),
+    - anchor mode, pending parameters (if any), tag mode,
+    - tag response message restore (volatile, no flash write).
+  Every flash write is counted against the wear budget. When the budget does not cover the mode
+  cycle only the reset is done; when it does not cover the pending parameters they stay pending.
+*/
+class RYUW122_TagWatchdog
+{
+public:
+    explicit RYUW122_TagWatchdog(RYUW122_UWB &uwb);
+
+    void setTrafficTimeout(uint32_t timeout);       // Probe when no +TAG_RCV arrived for this time [ms], 0 disables
+    void setHeartbeatInterval(uint32_t interval);   // Probe periodically [ms], 0 disables
+    void setFlashWriteBudget(uint32_t budget);      // Maximum number of flash writes done by the watchdog
+
+    bool setResponseMessage(const char *message, size_t messageLen = 0, bool padToMaxLength = false);
+    bool setPendingAddress(const char *address, size_t len = 0);
+    void setPendingTagParameters(uint16_t enableTime, uint16_t disableTime);
+    void setPendingCalibrationDistance(int8_t distance);
+    bool hasPendingConfiguration() const;
+
+    RYUW122_MessageState receive(RYUW122_MessageInfo &info);
+    RYUW122_WatchdogState update();
+    RYUW122_WatchdogState recover();
+
+    uint32_t getRecoveryCount() const;
+    uint32_t getLastRecoveryTime() const;
+    uint32_t getMaxRecoveryTime() const;
+    uint32_t getFlashWrites() const;
+    uint32_t getFlashWriteBudget() const;
+
+private:
+    enum PendingFlags : uint8_t
+    {
+        PENDING_ADDRESS     = 0x01,
+        PENDING_TAG_PARAMS  = 0x02,
+        PENDING_CALIBRATION = 0x04
+    };
+
+    RYUW122_UWB &uwb;
+
+    uint32_t trafficTimeout = 5000;        // Silence on +TAG_RCV before probing [ms]
+    uint32_t heartbeatInterval = 0;        // Periodic probe interval [ms], 0 disables
+    unsigned long lastTrafficTime = 0;
+    unsigned long lastProbeTime = 0;
+
+    char responseMessage[RYUW122_MAX_PAYLOAD + 1];
+    uint8_t responseMessageLen = 0;
+    bool responsePadToMaxLength = false;
+
+    uint8_t pendingFlags = 0;
+    char pendingAddress[9];                // 8 chars + null terminator
+    uint16_t pendingEnableTime = 0;
+    uint16_t pendingDisableTime = 0;
+    int8_t pendingCalibration = 0;
+
+    uint32_t flashWriteBudget = 1000;
+    uint32_t flashWrites = 0;
+    uint32_t recoveryCount = 0;
+    uint32_t lastRecoveryTime = 0;         // Duration of the last recovery [ms]
+    uint32_t maxRecoveryTime = 0;          // Longest recovery so far [ms]
+
+    uint8_t pendingFlashWrites() const;
+    bool applyPendingConfiguration();
+    bool restoreResponseMessage();
+    RYUW122_WatchdogState finishRecovery(unsigned long startTime, RYUW122_WatchdogState state);
+};
+
+#endif // RYUW122_HAS_TAG
+
+#endif // RYUW122_TAG_WATCHDOG_H
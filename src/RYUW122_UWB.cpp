@@ -6,6 +6,26 @@
 
 #include "Arduino.h"
 #include "RYUW122_UWB.h"
+#include "RYUW122_RateGovernor.h"
+
+// Constant strings used in more than one place, kept in flash
+static const char ResponseOk[] PROGMEM = "OK\r\n";
+static const char ResponseLine[] PROGMEM = "\r\n"; // Any complete line
+static const char ErrorPrefix[] PROGMEM = "+ERR=";
+#if RYUW122_HAS_ANCHOR
+static const char AnchorPrefix[] PROGMEM = "+ANCHOR_RCV=";
+#endif
+#if RYUW122_HAS_TAG
+static const char TagPrefix[] PROGMEM = "+TAG_RCV=";
+#endif
+
+#define FLASH_STRING(string) reinterpret_cast<RYUW122_FlashString>(string)
+
+#if RYUW122_PROFILE_TINY
+#define RYUW122_TEXT(string) F(string)
+#else
+#define RYUW122_TEXT(string) string
+#endif
 
 RYUW122_UWB::RYUW122_UWB(Stream &serial) : _serial(serial) {}
 
@@ -33,8 +53,7 @@ bool RYUW122_UWB::begin(int16_t resetPin, int16_t moduleResponseTimeout, int16_t
 
 bool RYUW122_UWB::isConnected()
 {
-    sendCommand("AT");
-    return readResponse("OK\r\n", moduleResponseTimeout);
+    return executeCommand(F("AT")) == RESULT_OK;
 }
 
 void RYUW122_UWB::reset()
@@ -68,133 +87,177 @@ uint16_t RYUW122_UWB::getDistanceResponseTimeout() const
     return distanceResponseTimeout;
 }
 
+void RYUW122_UWB::setRetryPolicy(const RYUW122_RetryPolicy &policy)
+{
+    retryPolicy = policy;
+}
+
+const RYUW122_RetryPolicy &RYUW122_UWB::getRetryPolicy() const
+{
+    return retryPolicy;
+}
+
+RYUW122_Result RYUW122_UWB::getLastResult() const
+{
+    return lastResult;
+}
+
+int16_t RYUW122_UWB::getLastErrorCode() const
+{
+    return lastErrorCode;
+}
+
+#if RYUW122_HAS_ANCHOR
+void RYUW122_UWB::setRateGovernor(RYUW122_RateGovernor *governor)
+{
+    rateGovernor = governor;
+}
+#endif
+
 bool RYUW122_UWB::resetSW()
 {
-    sendCommand("AT+RESET");
-    bool result = readResponse("READY\r\n", moduleResponseTimeout);
+    bool result = executeCommand(F("AT+RESET"), nullptr, 0, F("READY\r\n")) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
+bool RYUW122_UWB::waitReady(uint16_t timeout)
+{
+    if (timeout == 0)
+    {
+        timeout = moduleResponseTimeout;
+    }
+    return readResponse(F("READY\r\n"), timeout) == RESULT_OK;
+}
+
+int16_t RYUW122_UWB::getResetPin() const
+{
+    return resetPin;
+}
+
 bool RYUW122_UWB::setMode(RYUW122_Mode mode)
 {
+    const char *value;
     switch (mode)
     {
     case MODE_TAG:
-        sendCommandWithValue("AT+MODE=", "0");
+        value = PSTR("0");
         break;
     case MODE_ANCHOR:
-        sendCommandWithValue("AT+MODE=", "1");
+        value = PSTR("1");
         break;
     case MODE_SLEEP:
-        sendCommandWithValue("AT+MODE=", "2");
+        value = PSTR("2");
         break;
     default:
-        return false;
+        return invalidArgument();
     }
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    strcpy_P(messageBuffer, value);
+    bool result = executeCommand(F("AT+MODE="), messageBuffer) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::setBaudRate(RYUW122_BaudRate baudRate)
 {
+    const char *value;
     switch (baudRate)
     {
     case BAUD_9600:
-        sendCommandWithValue("AT+IPR=", "9600");
+        value = PSTR("9600");
         break;
     case BAUD_57600:
-        sendCommandWithValue("AT+IPR=", "57600");
+        value = PSTR("57600");
         break;
     case BAUD_115200:
-        sendCommandWithValue("AT+IPR=", "115200");
+        value = PSTR("115200");
         break;
     default:
-        return false;
+        return invalidArgument();
     }
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    strcpy_P(messageBuffer, value);
+    bool result = executeCommand(F("AT+IPR="), messageBuffer) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::setChannel(RYUW122_Channel channel)
 {
+    const char *value;
     switch (channel)
     {
     case CHANNEL_6489_6_MHz:
-        sendCommandWithValue("AT+CHANNEL=", "5");
+        value = PSTR("5");
         break;
     case CHANNEL_7987_2_MHz:
-        sendCommandWithValue("AT+CHANNEL=", "9");
+        value = PSTR("9");
         break;
     default:
-        return false;
+        return invalidArgument();
     }
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    strcpy_P(messageBuffer, value);
+    bool result = executeCommand(F("AT+CHANNEL="), messageBuffer) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::setBandwidth(RYUW122_Bandwidth bandwidth)
 {
+    const char *value;
     switch (bandwidth)
     {
     case BANDWIDTH_850_Kbps:
-        sendCommandWithValue("AT+BANDWIDTH=", "0");
+        value = PSTR("0");
         break;
     case BANDWIDTH_6_8_Mbps:
-        sendCommandWithValue("AT+BANDWIDTH=", "1");
+        value = PSTR("1");
         break;
     default:
-        return false;
+        return invalidArgument();
     }
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    strcpy_P(messageBuffer, value);
+    bool result = executeCommand(F("AT+BANDWIDTH="), messageBuffer) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::setNetworkID(const char* networkID, size_t len)
 {
-    if (!networkID) return false;
+    if (!networkID) return invalidArgument();
     if (len == 0) len = strnlen(networkID, 9); 
-    if (len > 8) return false;
+    if (len > 8) return invalidArgument();
 
     memcpy(messageBuffer, networkID, len);
     if (len < 8) memset(messageBuffer + len, ' ', 8 - len);
 
-    sendCommandWithValue("AT+NETWORKID=", messageBuffer, 8);
-
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    bool result = executeCommand(F("AT+NETWORKID="), messageBuffer, 8) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::setAddress(const char* address, size_t len)
 {
-    if (!address) return false;
-    if (len == 0) len = strnlen(address, 9); 
-    if (len > 8) return false;
+    return setAddress(RYUW122_Address::fromChars(address, len));
+}
 
-    memcpy(messageBuffer, address, len);
-    if (len < 8) memset(messageBuffer + len, ' ', 8 - len);
+bool RYUW122_UWB::setAddress(const RYUW122_Address &address)
+{
+    if (!address.isValid()) return invalidArgument();
 
-    sendCommandWithValue("AT+ADDRESS=", messageBuffer, 8);
+    address.toChars(messageBuffer);
 
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    bool result = executeCommand(F("AT+ADDRESS="), messageBuffer, 8) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::setPassword(const char* password, size_t len)
 {
-    if (!password) return false;
+    if (!password) return invalidArgument();
     if (len == 0) len = strnlen(password, 33); 
-    if (len > 32) return false;
+    if (len > 32) return invalidArgument();
 
-    sendCommandWithValue("AT+CPIN=", password, len);
-
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    bool result = executeCommand(F("AT+CPIN="), password, len) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
@@ -203,36 +266,45 @@ bool RYUW122_UWB::setTagParameters(uint16_t enableTime, uint16_t disableTime)
 {
     if (enableTime > 28000 || disableTime > 28000)
     {
-        return false;
+        return invalidArgument();
     }
     clearMessageBuffer();
-    snprintf(messageBuffer, sizeof(messageBuffer), "%d,%d", enableTime, disableTime);
-    sendCommandWithValue("AT+TAGD=", messageBuffer);
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    snprintf_P(messageBuffer, sizeof(messageBuffer), PSTR("%u,%u"), (unsigned)enableTime, (unsigned)disableTime);
+    bool result = executeCommand(F("AT+TAGD="), messageBuffer) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
+#if RYUW122_HAS_ANCHOR
 bool RYUW122_UWB::sendMessage(const char* address, const char* message, size_t addressLen, size_t messageLen, bool padToMaxLength, bool sendAsync)
 {
-    if (!address || !message) return false;
+    return sendMessage(RYUW122_Address::fromChars(address, addressLen), message, messageLen, padToMaxLength, sendAsync);
+}
+
+bool RYUW122_UWB::sendMessage(const RYUW122_Address &address, const char* message, size_t messageLen, bool padToMaxLength, bool sendAsync)
+{
+    if (!address.isValid() || !message) return invalidArgument();
 
-    if (addressLen == 0) addressLen = strnlen(address, 9);
-    if (messageLen == 0) messageLen = strnlen(message, 13);
+    if (messageLen == 0) messageLen = strnlen(message, RYUW122_MAX_PAYLOAD + 1);
 
-    if (addressLen > 8 || messageLen == 0 || messageLen > 12) return false;
+    if (messageLen == 0 || messageLen > RYUW122_MAX_PAYLOAD) return invalidArgument();
+
+    if (rateGovernor && !rateGovernor->acquire(address, millis()))
+    {
+        lastResult = RESULT_THROTTLED;
+        return false;
+    }
 
     clearMessageBuffer();
 
-    // Pad the address with spaces to ensure it is exactly 8 characters
-    memset(messageBuffer, ' ', 8);
-    memcpy(messageBuffer, address, addressLen);
+    // Packed address is already padded with spaces to exactly 8 characters
+    address.toChars(messageBuffer);
 
     char* ptr = messageBuffer + 8;
-    size_t finalLen = padToMaxLength ? 12 : messageLen;
+    size_t finalLen = padToMaxLength ? RYUW122_MAX_PAYLOAD : messageLen;
 
     // Add the header: ,len,
-    int n = snprintf(ptr, sizeof(messageBuffer) - 8, ",%d,", finalLen);
+    int n = snprintf_P(ptr, sizeof(messageBuffer) - 8, PSTR(",%u,"), (unsigned)finalLen);
     if (n < 0 || (size_t)n >= sizeof(messageBuffer) - 8) return false;
 
     ptr += n;
@@ -240,52 +312,66 @@ bool RYUW122_UWB::sendMessage(const char* address, const char* message, size_t a
     // Copy message content
     memcpy(ptr, message, messageLen);
 
-    // Pad message to 12 bytes if requested
-    if (padToMaxLength && messageLen < 12)
-        memset(ptr + messageLen, ' ', 12 - messageLen);
-
-    sendCommandWithValue("AT+ANCHOR_SEND=", messageBuffer);
+    // Pad message to the maximum length if requested
+    if (padToMaxLength && messageLen < RYUW122_MAX_PAYLOAD)
+        memset(ptr + messageLen, ' ', RYUW122_MAX_PAYLOAD - messageLen);
 
-    if (sendAsync) return true; // For async, we don't wait for response
-    return readResponse("OK\r\n", moduleResponseTimeout);
+    if (sendAsync)
+    {
+        sendCommandWithValue(F("AT+ANCHOR_SEND="), messageBuffer);
+        return true; // For async, we don't wait for response
+    }
+    return executeCommand(F("AT+ANCHOR_SEND="), messageBuffer, 0, nullptr, &address) == RESULT_OK;
 }
 
 bool RYUW122_UWB::sendMessageAsync(const char* address, const char* message, size_t addressLen, size_t messageLen, bool padToMaxLength) 
+{
+    return sendMessageAsync(RYUW122_Address::fromChars(address, addressLen), message, messageLen, padToMaxLength);
+}
+
+bool RYUW122_UWB::sendMessageAsync(const RYUW122_Address &address, const char* message, size_t messageLen, bool padToMaxLength) 
 {
     if (isAsyncMessageSend()) return false; // Cannot send another async message while waiting for a response. Do not reset async message state.
 
-    bool result = sendMessage(address, message, addressLen, messageLen, padToMaxLength, true);
+    bool result = sendMessage(address, message, messageLen, padToMaxLength, true);
     if (!result) return false; // Message have wrong format or size
 
     expectedAsyncMessageTime = millis() + moduleResponseTimeout; // Set expected time for response
+    strncpy(asyncCommand, messageBuffer, sizeof(asyncCommand) - 1); // Keep the command for retries
+    asyncCommand[sizeof(asyncCommand) - 1] = '\0';
+    asyncAddress = address;
+    asyncAttempt = 0;
+    asyncRetryTime = 0;
     clearMessageBuffer(); // Clear message buffer for next response
     return true; // Async message sent successfully
 }
+#endif
 
+#if RYUW122_HAS_TAG
 bool RYUW122_UWB::setTagResponseMessage(const char* message, size_t messageLen, bool restart, bool padToMaxLength) 
 {
     if (messageLen == 0) {
-        messageLen = strnlen(message, 13); // Max 12 chars + terminator
+        messageLen = strnlen(message, RYUW122_MAX_PAYLOAD + 1); // Max 12 chars + terminator
     }
-    if (messageLen == 0 || messageLen > 12) return false;
+    if (messageLen == 0 || messageLen > RYUW122_MAX_PAYLOAD) return invalidArgument();
 
-    size_t finalLen = padToMaxLength ? 12 : messageLen;
+    size_t finalLen = padToMaxLength ? RYUW122_MAX_PAYLOAD : messageLen;
     clearMessageBuffer();
 
-    int n = snprintf(messageBuffer, sizeof(messageBuffer), "%u,", (unsigned)finalLen);
+    int n = snprintf_P(messageBuffer, sizeof(messageBuffer), PSTR("%u,"), (unsigned)finalLen);
     if (n < 0 || (size_t)n >= sizeof(messageBuffer)) return false;
 
     memcpy(messageBuffer + n, message, messageLen);
 
-    if (padToMaxLength && messageLen < 12) {
-        memset(messageBuffer + n + messageLen, ' ', 12 - messageLen);
+    if (padToMaxLength && messageLen < RYUW122_MAX_PAYLOAD) {
+        memset(messageBuffer + n + messageLen, ' ', RYUW122_MAX_PAYLOAD - messageLen);
     }
 
     if (restart) reset();
 
-    sendCommandWithValue("AT+TAG_SEND=", messageBuffer);
-    return readResponse("OK\r\n", moduleResponseTimeout);
+    return executeCommand(F("AT+TAG_SEND="), messageBuffer) == RESULT_OK;
 }
+#endif
 
 bool RYUW122_UWB::receiveMessage(RYUW122_MessageInfo &info, uint16_t timeout)
 {
@@ -294,108 +380,152 @@ bool RYUW122_UWB::receiveMessage(RYUW122_MessageInfo &info, uint16_t timeout)
         timeout = moduleResponseTimeout;
     }
 
-    if (readResponse("\r\n", timeout))
+    if (popReceived(info, RECEIVE_ANY)) return true;
+
+    if (readResponse(FLASH_STRING(ResponseLine), timeout, false) == RESULT_OK)
     {
-        if (strstr(messageBuffer, "ANCHOR_RCV="))
+#if RYUW122_HAS_ANCHOR
+        if (strstr_P(messageBuffer, AnchorPrefix))
         {
             return parseAnchorResponse(messageBuffer, info);
         }
-        else if (strstr(messageBuffer, "TAG_RCV="))
+#endif
+#if RYUW122_HAS_TAG
+        if (strstr_P(messageBuffer, TagPrefix))
         {
             return parseTagResponse(messageBuffer, info);
         }
+#endif
     }
     return false;
 }
 
+#if RYUW122_HAS_ANCHOR
 RYUW122_MessageState RYUW122_UWB::receiveMessageAsyncAnchor(RYUW122_MessageInfo &info)
 {
     if (!isAsyncMessageSend()) return MESSAGE_NOT_REQUESTED;
 
-    while (readResponseAsync("\r\n"))  // Read lines while data is available
+    if (asyncRetryTime != 0) // A retry is scheduled, do not block while waiting for it
     {
-        if (strstr(messageBuffer, "OK\r\n"))
+        if ((long)(millis() - asyncRetryTime) < 0) return MESSAGE_WAITING;
+
+        if (rateGovernor && !rateGovernor->acquire(asyncAddress, millis()))
         {
-            // Ignore the "OK" response, read the next line
-            indexAsyncMessage = 0;
-            clearMessageBuffer();
-            continue;
+            asyncRetryTime = millis() + rateGovernor->timeUntilAllowed(asyncAddress, millis());
+            if (asyncRetryTime == 0) asyncRetryTime = 1;
+            return MESSAGE_WAITING;
         }
 
-        if (strstr(messageBuffer, "ANCHOR_RCV="))
+        asyncRetryTime = 0;
+        sendCommandWithValue(F("AT+ANCHOR_SEND="), asyncCommand);
+        expectedAsyncMessageTime = millis() + moduleResponseTimeout;
+    }
+
+    // Response may have been captured into the queue while another command was executed
+    if (popReceived(info, RECEIVE_ANCHOR, asyncAddress)) return completeAsyncMessage(true);
+
+    while (readReceiveLine())  // Read lines while data is available
+    {
+        if (strstr_P(receiveLine, AnchorPrefix))
         {
-            bool success = parseAnchorResponse(messageBuffer, info);
-            resetAsyncMessage(); // Async communication completed successfully
-            if (success) return MESSAGE_RECEIVED; 
-            return MESSAGE_PARSE_ERROR; // Parsing failed, but we received a response
+            bool success = parseAnchorResponse(receiveLine, info);
+            clearReceiveLine();
+            if (success && RYUW122_Address::fromChars(info.address) != asyncAddress)
+            {
+                // Late response to an earlier poll, keep it and wait for the expected tag
+                pushReceived(info);
+                continue;
+            }
+            return completeAsyncMessage(success);
+        }
+
+        if (parseErrorResponse(receiveLine))
+        {
+            // Module rejected the command, there is no point in waiting for the timeout
+            clearReceiveLine();
+            return retryAsyncMessage(MESSAGE_ERROR);
         }
 
-        // Received an unexpected line, clear the buffer and wait for the next
-        indexAsyncMessage = 0;
-        clearMessageBuffer();
+        // "OK" or an unrelated line, keep received messages and read the next line
+        queueReceivedLine(receiveLine);
+        clearReceiveLine();
     }
 
     // Check for timeout – reset the async state if no valid response was received in time
     if (millis() > expectedAsyncMessageTime) {
-        resetAsyncMessage();
-        return MESSAGE_TIMEOUT;
+        return retryAsyncMessage(MESSAGE_TIMEOUT);
     }
 
     return MESSAGE_WAITING; // Still waiting for a response
 }
+#endif
 
+#if RYUW122_HAS_TAG
 RYUW122_MessageState RYUW122_UWB::receiveMessageAsyncTag(RYUW122_MessageInfo &info)
 {
-    while (readResponseAsync("\r\n"))  // Read lines while data is available
-    {
-        if (strstr(messageBuffer, "OK\r\n"))
-        {
-            // Ignore the "OK" response, read the next line
-            indexAsyncMessage = 0;
-            clearMessageBuffer();
-            continue;
-        }
+    if (popReceived(info, RECEIVE_TAG)) return MESSAGE_RECEIVED;
 
-        if (strstr(messageBuffer, "TAG_RCV="))
+    while (readReceiveLine())  // Read lines while data is available
+    {
+        if (strstr_P(receiveLine, TagPrefix))
         {
-            bool success = parseTagResponse(messageBuffer, info);
-            resetAsyncMessage(); // Async communication completed successfully
+            bool success = parseTagResponse(receiveLine, info);
+            clearReceiveLine();
             if (success) return MESSAGE_RECEIVED; 
             return MESSAGE_PARSE_ERROR; // Parsing failed, but we received a response
         }
 
-        // Received an unexpected line, clear the buffer and wait for the next
-        indexAsyncMessage = 0;
-        clearMessageBuffer();
+        // "OK" or an unrelated line, keep received messages and read the next line
+        queueReceivedLine(receiveLine);
+        clearReceiveLine();
     }
 
     return MESSAGE_WAITING; // Still waiting for a response   
 }
+#endif
+
+bool RYUW122_UWB::receiveNext(RYUW122_MessageInfo &info)
+{
+    captureReceived();
+    return popReceived(info, RECEIVE_ANY);
+}
 
+uint8_t RYUW122_UWB::getReceiveQueueCount() const
+{
+    return receiveCount;
+}
+
+uint32_t RYUW122_UWB::getReceiveOverflowCount() const
+{
+    return receiveOverflowCount;
+}
+
+void RYUW122_UWB::clearReceiveQueue()
+{
+    receiveHead = 0;
+    receiveCount = 0;
+}
 
 bool RYUW122_UWB::setCalibrationDistance(int8_t distance)
 {
     if (distance < -100 || distance > 100)
     {
-        return false;
+        return invalidArgument();
     }
 
     clearMessageBuffer();
-    snprintf(messageBuffer, sizeof(messageBuffer), "%d", (int)distance);
-
-    sendCommandWithValue("AT+CAL=", messageBuffer);
+    snprintf_P(messageBuffer, sizeof(messageBuffer), PSTR("%d"), (int)distance);
 
-    bool result = readResponse("OK\r\n", moduleResponseTimeout);
+    bool result = executeCommand(F("AT+CAL="), messageBuffer) == RESULT_OK;
     delay(afterResponseDelay);
     return result;
 }
 
 bool RYUW122_UWB::getMode(RYUW122_Mode &mode)
 {
-    sendCommand("AT+MODE?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    if (executeCommand(F("AT+MODE?"), nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *ptr = strstr(messageBuffer, "=");
+        const char *ptr = strchr(messageBuffer, '=');
         if (ptr && strlen(ptr) >= 2)
         {
             char modeChar = ptr[1];
@@ -422,10 +552,9 @@ bool RYUW122_UWB::getMode(RYUW122_Mode &mode)
 
 bool RYUW122_UWB::getBaudRate(RYUW122_BaudRate &rate)
 {
-    sendCommand("AT+IPR?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    if (executeCommand(F("AT+IPR?"), nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *ptr = strstr(messageBuffer, "=");
+        const char *ptr = strchr(messageBuffer, '=');
         if (ptr)
         {
             int value = atoi(ptr + 1);
@@ -452,10 +581,9 @@ bool RYUW122_UWB::getBaudRate(RYUW122_BaudRate &rate)
 
 bool RYUW122_UWB::getChannel(RYUW122_Channel &channel)
 {
-    sendCommand("AT+CHANNEL?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    if (executeCommand(F("AT+CHANNEL?"), nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *ptr = strstr(messageBuffer, "=");
+        const char *ptr = strchr(messageBuffer, '=');
         if (ptr && strlen(ptr) >= 2)
         {
             char chanChar = ptr[1];
@@ -479,10 +607,9 @@ bool RYUW122_UWB::getChannel(RYUW122_Channel &channel)
 
 bool RYUW122_UWB::getBandwidth(RYUW122_Bandwidth &bandwidth)
 {
-    sendCommand("AT+BANDWIDTH?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    if (executeCommand(F("AT+BANDWIDTH?"), nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *ptr = strstr(messageBuffer, "=");
+        const char *ptr = strchr(messageBuffer, '=');
         if (ptr && strlen(ptr) >= 2)
         {
             char modeChar = ptr[1];
@@ -506,144 +633,44 @@ bool RYUW122_UWB::getBandwidth(RYUW122_Bandwidth &bandwidth)
 
 bool RYUW122_UWB::getNetworkID(char* buffer, size_t bufferSize)
 {
-    const size_t expectedLen = 8; 
-
-    if (bufferSize < expectedLen) 
-        return false;
-
-    sendCommand("AT+NETWORKID?");
-    if (readResponse("\r\n", moduleResponseTimeout))
-    {
-        const char* prefix = "+NETWORKID=";
-        char* found = strstr(messageBuffer, prefix);
-        if (found)
-        {
-            char* id = found + strlen(prefix);
-            char* newline = strchr(id, '\n');
-            if (newline)
-                *newline = '\0';
-
-            if (bufferSize == expectedLen) {
-                memcpy(buffer, id, expectedLen);
-            } else {
-                strncpy(buffer, id, bufferSize - 1);
-                buffer[bufferSize - 1] = '\0';
-            }
-            return true;
-        }
-    }
-    return false;
+    return getStringParameter(F("AT+NETWORKID?"), PSTR("+NETWORKID="), buffer, bufferSize, 8);
 }
 
 bool RYUW122_UWB::getAddress(char* buffer, size_t bufferSize)
 {
-    const size_t expectedLen = 8; 
-
-    if (bufferSize < expectedLen) 
-        return false; 
-
-    sendCommand("AT+ADDRESS?");
-    if (readResponse("\r\n", moduleResponseTimeout))
-    {
-        const char* addressPrefix = "+ADDRESS=";
-        char* found = strstr(messageBuffer, addressPrefix);
-        if (found)
-        {
-            char* id = found + strlen(addressPrefix);
-            char* newline = strchr(id, '\n');
-            if (newline)
-                *newline = '\0';
-
-            if (bufferSize == expectedLen) {
-                memcpy(buffer, id, expectedLen);
-            } else {
-                strncpy(buffer, id, bufferSize - 1);
-                buffer[bufferSize - 1] = '\0';
-            }
-            return true;
-        }
-    }
-    return false;
+    return getStringParameter(F("AT+ADDRESS?"), PSTR("+ADDRESS="), buffer, bufferSize, 8);
 }
 
 bool RYUW122_UWB::getUID(char* buffer, size_t bufferSize)
 {
-    const size_t expectedLen = 12; 
-
-    if (bufferSize < expectedLen)
-        return false; 
-
-    sendCommand("AT+UID?");
-    if (readResponse("\r\n", moduleResponseTimeout))
-    {
-        const char* uidPrefix = "+UID=";
-        char* found = strstr(messageBuffer, uidPrefix);
-        if (found)
-        {
-            char* id = found + strlen(uidPrefix);
-            char* newline = strchr(id, '\n');
-            if (newline)
-                *newline = '\0';
-
-            if (bufferSize == expectedLen) {
-                memcpy(buffer, id, expectedLen);
-            } else {
-                strncpy(buffer, id, bufferSize - 1);
-                buffer[bufferSize - 1] = '\0';
-            }
-            return true;
-        }
-    }
-    return false;
+    return getStringParameter(F("AT+UID?"), PSTR("+UID="), buffer, bufferSize, 12);
 }
 
 bool RYUW122_UWB::getPassword(char *buffer, size_t bufferSize)
 {
-    const size_t expectedLen = 32; 
-
-    if (bufferSize < expectedLen)
-        return false;
-
-    sendCommand("AT+CPIN?");
-    if (readResponse("\r\n", moduleResponseTimeout))
-    {
-        const char *passwordPrefix = "+CPIN=";
-        char *found = strstr(messageBuffer, passwordPrefix);
-        if (found)
-        {
-            char *pwd = found + strlen(passwordPrefix);
-            char *newline = strchr(pwd, '\n');
-            if (newline)
-                *newline = '\0';
-
-            if (bufferSize == expectedLen) {
-                memcpy(buffer, pwd, expectedLen);
-            } else {
-                strncpy(buffer, pwd, bufferSize - 1);
-                buffer[bufferSize - 1] = '\0';
-            }
-            return true;
-        }
-    }
-    return false;
+    return getStringParameter(F("AT+CPIN?"), PSTR("+CPIN="), buffer, bufferSize, 32);
 }
 
 bool RYUW122_UWB::getTagParameters(uint16_t &enableTime, uint16_t &disableTime)
 {
-    sendCommand("AT+TAGD?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    if (executeCommand(F("AT+TAGD?"), nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *tagParamsPrefix = "+TAGD=";
-        char *found = strstr(messageBuffer, tagParamsPrefix);
-        if (found)
+        char *params = findParameter(PSTR("+TAGD="));
+        if (params)
         {
-            char *params = found + strlen(tagParamsPrefix);
-            int enable = 0, disable = 0;
-            if (sscanf(params, "%d,%d", &enable, &disable) == 2)
+            // strtol instead of sscanf, which would pull the whole scanf implementation in
+            char *end;
+            long enable = strtol(params, &end, 10);
+            if (end != params && *end == ',')
             {
-                enableTime = (uint16_t)enable;
-                disableTime = (uint16_t)disable;
-                return true;
+                char *second = end + 1;
+                long disable = strtol(second, &end, 10);
+                if (end != second)
+                {
+                    enableTime = (uint16_t)enable;
+                    disableTime = (uint16_t)disable;
+                    return true;
+                }
             }
         }
     }
@@ -652,16 +679,14 @@ bool RYUW122_UWB::getTagParameters(uint16_t &enableTime, uint16_t &disableTime)
 
 bool RYUW122_UWB::getCalibrationDistance(int8_t &distance)
 {
-    sendCommand("AT+CAL?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    if (executeCommand(F("AT+CAL?"), nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *calPrefix = "+CAL=";
-        char *found = strstr(messageBuffer, calPrefix);
-        if (found)
+        char *valStr = findParameter(PSTR("+CAL="));
+        if (valStr)
         {
-            char *valStr = found + strlen(calPrefix);
-            int value = 0;
-            if (sscanf(valStr, "%d", &value) == 1 && value >= -100 && value <= 100)
+            char *end;
+            long value = strtol(valStr, &end, 10);
+            if (end != valStr && value >= -100 && value <= 100)
             {
                 distance = (int8_t)value;
                 return true;
@@ -673,34 +698,49 @@ bool RYUW122_UWB::getCalibrationDistance(int8_t &distance)
 
 bool RYUW122_UWB::getFirmwareVersion(char *buffer, size_t bufferSize)
 {
-    sendCommand("AT+VER?");
-    if (readResponse("\r\n", moduleResponseTimeout))
+    return getStringParameter(F("AT+VER?"), PSTR("+VER="), buffer, bufferSize, 0);
+}
+
+bool RYUW122_UWB::getStringParameter(RYUW122_FlashString cmd, const char *prefix, char *buffer, size_t bufferSize, size_t expectedLen)
+{
+    if (bufferSize < expectedLen || bufferSize == 0)
+        return false;
+
+    if (executeCommand(cmd, nullptr, 0, FLASH_STRING(ResponseLine)) == RESULT_OK)
     {
-        const char *versionPrefix = "+VER=";
-        char *found = strstr(messageBuffer, versionPrefix);
-        if (found)
+        char *value = findParameter(prefix);
+        if (value)
         {
-            char *verStr = found + strlen(versionPrefix);
-            char *newline = strchr(verStr, '\n');
+            char *newline = strchr(value, '\n');
             if (newline)
                 *newline = '\0';
 
-            strncpy(buffer, verStr, bufferSize - 1);
-            buffer[bufferSize - 1] = '\0'; 
+            if (expectedLen != 0 && bufferSize == expectedLen) {
+                memcpy(buffer, value, expectedLen);
+            } else {
+                strncpy(buffer, value, bufferSize - 1);
+                buffer[bufferSize - 1] = '\0';
+            }
             return true;
         }
     }
     return false;
 }
 
+char *RYUW122_UWB::findParameter(const char *prefix)
+{
+    char *found = strstr_P(messageBuffer, prefix);
+    return found ? found + strlen_P(prefix) : nullptr;
+}
+
+#if RYUW122_HAS_ANCHOR
 bool RYUW122_UWB::parseAnchorResponse(char *response, RYUW122_MessageInfo &info)
 {
-    const char *prefix = "+ANCHOR_RCV=";
-    char *start = strstr(response, prefix);
+    char *start = strstr_P(response, AnchorPrefix);
     if (!start)
         return false;
 
-    start += strlen(prefix);
+    start += sizeof(AnchorPrefix) - 1;
 
     char *ptr1 = strchr(start, ',');
     if (!ptr1)
@@ -725,7 +765,7 @@ bool RYUW122_UWB::parseAnchorResponse(char *response, RYUW122_MessageInfo &info)
     char *distanceStr = ptr3 + 1;
     while (*distanceStr == ' ')
         distanceStr++;
-    char *cmPtr = strstr(distanceStr, "cm");
+    char *cmPtr = strstr_P(distanceStr, PSTR("cm"));
     if (cmPtr)
         *cmPtr = '\0'; 
     info.distance = atoi(distanceStr);
@@ -733,14 +773,16 @@ bool RYUW122_UWB::parseAnchorResponse(char *response, RYUW122_MessageInfo &info)
     return true;
 }
 
+#endif
+
+#if RYUW122_HAS_TAG
 bool RYUW122_UWB::parseTagResponse(char* response, RYUW122_MessageInfo& info)
 {
-    const char* prefix = "+TAG_RCV=";
-    char* start = strstr(response, prefix);
+    char* start = strstr_P(response, TagPrefix);
     if (!start)
         return false;
 
-    start += strlen(prefix);
+    start += sizeof(TagPrefix) - 1;
 
     char* ptr = strchr(start, ',');
     if (!ptr)
@@ -758,29 +800,30 @@ bool RYUW122_UWB::parseTagResponse(char* response, RYUW122_MessageInfo& info)
         }
     }
 
+#if RYUW122_HAS_ANCHOR
     info.address[0] = '\0'; 
     info.distance = 0;
+#endif
 
     return true;
 }
+#endif
 
 void RYUW122_UWB::clearMessageBuffer()
 {
     memset(messageBuffer, 0, sizeof(messageBuffer));
 }
 
-void RYUW122_UWB::sendCommand(const char *cmd)
+void RYUW122_UWB::sendCommand(RYUW122_FlashString cmd)
 {
-    while (_serial.available())
-        _serial.read();
+    captureReceived();
     _serial.print(cmd);
     _serial.println();
 }
 
-void RYUW122_UWB::sendCommandWithValue(const char *cmd, const char *val, uint8_t valLength)
+void RYUW122_UWB::sendCommandWithValue(RYUW122_FlashString cmd, const char *val, uint8_t valLength)
 {
-    while (_serial.available())
-        _serial.read();
+    captureReceived();
     _serial.print(cmd);
     if (valLength  == 0)
         _serial.print(val);
@@ -789,11 +832,60 @@ void RYUW122_UWB::sendCommandWithValue(const char *cmd, const char *val, uint8_t
     _serial.println();
 }
 
-bool RYUW122_UWB::readResponse(const char *expectedResponse, uint32_t timeout)
+RYUW122_Result RYUW122_UWB::executeCommand(RYUW122_FlashString cmd, const char *val, uint8_t valLength, RYUW122_FlashString expectedResponse,
+                                           const RYUW122_Address *governedTag)
 {
+#if !RYUW122_HAS_ANCHOR
+    (void)governedTag;
+#endif
+    char value[MessageBufferSize]; // Value may live in messageBuffer, which is overwritten by readResponse
+    if (val && retryPolicy.maxRetries > 0)
+    {
+        size_t len = valLength ? valLength : strnlen(val, sizeof(value) - 1);
+        memcpy(value, val, len);
+        value[len] = '\0';
+        val = value;
+    }
+
+    for (uint8_t attempt = 0;; ++attempt)
+    {
+        if (val)
+            sendCommandWithValue(cmd, val, valLength);
+        else
+            sendCommand(cmd);
+
+        RYUW122_Result result = readResponse(expectedResponse, moduleResponseTimeout);
+#if RYUW122_HAS_ANCHOR
+        if (rateGovernor && governedTag && result == RESULT_TIMEOUT) rateGovernor->reportTimeout(*governedTag);
+#endif
+        if (!shouldRetry(result, attempt))
+            return result;
+
+        uint32_t startTime = millis();
+        uint16_t backoff = retryBackoff(attempt);
+        while (millis() - startTime < backoff)
+            yield();
+
+#if RYUW122_HAS_ANCHOR
+        // The caller already acquired the first poll; a retry is another poll and must not exceed the limits either
+        while (rateGovernor && governedTag && !rateGovernor->acquire(*governedTag, millis()))
+        {
+            startTime = millis();
+            uint32_t wait = rateGovernor->timeUntilAllowed(*governedTag, startTime);
+            while (millis() - startTime < wait)
+                yield();
+        }
+#endif
+    }
+}
+
+RYUW122_Result RYUW122_UWB::readResponse(RYUW122_FlashString expectedResponse, uint32_t timeout, bool captureMessages)
+{
+    const char *expected = expectedResponse ? reinterpret_cast<const char *>(expectedResponse) : ResponseOk;
     clearMessageBuffer();
 
     size_t index = 0;
+    size_t lineStart = 0;
     uint32_t startTime = millis();
 
     while (millis() - startTime < timeout)
@@ -802,49 +894,252 @@ bool RYUW122_UWB::readResponse(const char *expectedResponse, uint32_t timeout)
         {
             char c = _serial.read();
 
-            if (index < sizeof(messageBuffer) - 1)
+            if (receiveLineIndex > 0)
             {
-                messageBuffer[index++] = c;
+                // Finish the line started before the command was sent and check it like any other line
+                if (!appendReceiveLine(c))
+                    continue;
+
+                size_t len = strnlen(receiveLine, sizeof(messageBuffer) - 1 - lineStart);
+                memcpy(messageBuffer + lineStart, receiveLine, len);
+                index = lineStart + len;
                 messageBuffer[index] = '\0';
+                clearReceiveLine();
             }
+            else
+            {
+                if (index < sizeof(messageBuffer) - 1)
+                {
+                    messageBuffer[index++] = c;
+                    messageBuffer[index] = '\0';
+                }
+
+                // Responses are complete lines, check them once the line ends
+                if (c != '\n')
+                    continue;
+            }
+
+            char *line = messageBuffer + lineStart;
+            bool isMessage = isMessageLine(line);
 
-            if (strstr(messageBuffer, expectedResponse))
+            // Message received in the meantime, keep it and remove it from the response
+            if (isMessage && captureMessages)
             {
-                return true;
+                queueReceivedLine(line);
+                index = lineStart;
+                messageBuffer[index] = '\0';
+                continue;
+            }
+
+            // Error line is complete, return immediately instead of waiting for the timeout; a payload may contain "+ERR="
+            if (!isMessage && parseErrorResponse(line))
+            {
+                lastResult = RESULT_MODULE_ERROR;
+                return lastResult;
             }
+
+            if (strstr_P(line, expected))
+            {
+                lastResult = RESULT_OK;
+                return lastResult;
+            }
+            lineStart = index;
         }
     }
 
-    return strstr(messageBuffer, expectedResponse) != nullptr;
+    lastResult = strstr_P(messageBuffer, expected) ? RESULT_OK : RESULT_TIMEOUT;
+    return lastResult;
 }
 
-bool RYUW122_UWB::readResponseAsync(const char *expectedResponse)
+bool RYUW122_UWB::parseErrorResponse(const char *response)
 {
-    while (_serial.available())
+    const char *found = strstr_P(response, ErrorPrefix);
+    if (!found)
+        return false;
+
+    lastErrorCode = atoi(found + sizeof(ErrorPrefix) - 1);
+    return true;
+}
+
+bool RYUW122_UWB::shouldRetry(RYUW122_Result result, uint8_t attempt) const
+{
+    if (attempt >= retryPolicy.maxRetries)
+        return false;
+    if (result == RESULT_TIMEOUT)
+        return true;
+    return result == RESULT_MODULE_ERROR && retryPolicy.retryOnModuleError;
+}
+
+uint16_t RYUW122_UWB::retryBackoff(uint8_t attempt) const
+{
+    uint32_t backoff = (uint32_t)retryPolicy.initialBackoff << (attempt < 16 ? attempt : 16);
+    return backoff > retryPolicy.maxBackoff ? retryPolicy.maxBackoff : (uint16_t)backoff;
+}
+
+#if RYUW122_HAS_ANCHOR
+RYUW122_MessageState RYUW122_UWB::retryAsyncMessage(RYUW122_MessageState failure)
+{
+    lastResult = failure == MESSAGE_ERROR ? RESULT_MODULE_ERROR : RESULT_TIMEOUT;
+    if (rateGovernor && failure == MESSAGE_TIMEOUT) rateGovernor->reportTimeout(asyncAddress);
+    if (!shouldRetry(lastResult, asyncAttempt))
     {
-        char c = _serial.read();
+        resetAsyncMessage();
+        return failure;
+    }
 
-        if (indexAsyncMessage < sizeof(messageBuffer) - 1)
+    // Schedule the retry, receiveMessageAsyncAnchor() resends the command once the backoff elapses
+    asyncRetryTime = millis() + retryBackoff(asyncAttempt);
+    if (asyncRetryTime == 0) asyncRetryTime = 1;
+    asyncAttempt++;
+    return MESSAGE_WAITING;
+}
+#endif
+
+bool RYUW122_UWB::invalidArgument()
+{
+    lastResult = RESULT_INVALID_ARGUMENT;
+    return false;
+}
+
+bool RYUW122_UWB::readReceiveLine()
+{
+    while (_serial.available())
+    {
+        if (appendReceiveLine(_serial.read()))
         {
-            messageBuffer[indexAsyncMessage++] = c;
-            messageBuffer[indexAsyncMessage] = '\0';
+            return true;
         }
+    }
+
+    return false; // No complete line yet
+}
+
+bool RYUW122_UWB::appendReceiveLine(char c)
+{
+    if (receiveLineIndex < sizeof(receiveLine) - 1)
+    {
+        receiveLine[receiveLineIndex++] = c;
+        receiveLine[receiveLineIndex] = '\0';
+    }
+    return c == '\n';
+}
+
+void RYUW122_UWB::clearReceiveLine()
+{
+    receiveLineIndex = 0;
+    receiveLine[0] = '\0';
+}
+
+void RYUW122_UWB::captureReceived()
+{
+    while (readReceiveLine())
+    {
+        queueReceivedLine(receiveLine);
+        clearReceiveLine();
+    }
+}
+
+bool RYUW122_UWB::isMessageLine(const char *line)
+{
+#if RYUW122_HAS_ANCHOR
+    if (strstr_P(line, AnchorPrefix)) return true;
+#endif
+#if RYUW122_HAS_TAG
+    if (strstr_P(line, TagPrefix)) return true;
+#endif
+    return false;
+}
+
+bool RYUW122_UWB::queueReceivedLine(char *line)
+{
+    RYUW122_MessageInfo info;
+#if RYUW122_HAS_ANCHOR
+    if (strstr_P(line, AnchorPrefix))
+    {
+        if (parseAnchorResponse(line, info)) pushReceived(info);
+        return true;
+    }
+#endif
+#if RYUW122_HAS_TAG
+    if (strstr_P(line, TagPrefix))
+    {
+        if (parseTagResponse(line, info)) pushReceived(info);
+        return true;
+    }
+#endif
+    return false; // Not a message line
+}
 
-        if (strstr(messageBuffer, expectedResponse))
+void RYUW122_UWB::pushReceived(const RYUW122_MessageInfo &info)
+{
+#if RYUW122_RECEIVE_QUEUE_SIZE > 0
+    if (receiveCount == RYUW122_RECEIVE_QUEUE_SIZE)
+    {
+        // Drop the oldest message, the newest range is the most useful one
+        receiveHead = (receiveHead + 1) % RYUW122_RECEIVE_QUEUE_SIZE;
+        receiveCount--;
+        receiveOverflowCount++;
+    }
+    receiveQueue[(receiveHead + receiveCount) % RYUW122_RECEIVE_QUEUE_SIZE] = info;
+    receiveCount++;
+#else
+    (void)info;
+    receiveOverflowCount++;
+#endif
+}
+
+bool RYUW122_UWB::popReceived(RYUW122_MessageInfo &info, ReceiveKind kind, const RYUW122_Address &address)
+{
+#if RYUW122_RECEIVE_QUEUE_SIZE > 0
+    for (uint8_t i = 0; i < receiveCount; ++i)
+    {
+        const RYUW122_MessageInfo &queued = receiveQueue[(receiveHead + i) % RYUW122_RECEIVE_QUEUE_SIZE];
+
+#if RYUW122_HAS_ANCHOR && RYUW122_HAS_TAG
+        bool fromAnchor = queued.address[0] != '\0'; // +TAG_RCV carries no address
+#else
+        bool fromAnchor = RYUW122_HAS_ANCHOR; // Only one kind of message is parsed
+#endif
+        if (kind == RECEIVE_TAG && fromAnchor) continue;
+        if (kind == RECEIVE_ANCHOR && !fromAnchor) continue;
+#if RYUW122_HAS_ANCHOR
+        if (kind == RECEIVE_ANCHOR && address.isValid() && RYUW122_Address::fromChars(queued.address) != address) continue;
+#else
+        (void)address;
+#endif
+
+        info = queued;
+
+        // Close the gap, messages behind the taken one keep their order
+        for (uint8_t j = i; j + 1 < receiveCount; ++j)
         {
-            return true;
+            receiveQueue[(receiveHead + j) % RYUW122_RECEIVE_QUEUE_SIZE] = receiveQueue[(receiveHead + j + 1) % RYUW122_RECEIVE_QUEUE_SIZE];
         }
+        receiveCount--;
+        return true;
     }
+#else
+    (void)info;
+    (void)kind;
+    (void)address;
+#endif
+    return false;
+}
 
-    return false; // No response found yet
+#if RYUW122_HAS_ANCHOR
+RYUW122_MessageState RYUW122_UWB::completeAsyncMessage(bool success)
+{
+    if (rateGovernor) rateGovernor->reportSuccess(asyncAddress);
+    resetAsyncMessage(); // Async communication completed successfully
+    if (success) return MESSAGE_RECEIVED;
+    return MESSAGE_PARSE_ERROR; // Parsing failed, but we received a response
 }
 
 void RYUW122_UWB::resetAsyncMessage()
 {
-    indexAsyncMessage = 0;
+    // Serial buffer is not flushed, messages arriving back-to-back are read into the receive queue
     expectedAsyncMessageTime = 0;
-    clearMessageBuffer();
-    while (_serial.available()) _serial.read(); // Clear serial buffer to avoid any leftover data
+    asyncRetryTime = 0;
 }
 
 bool RYUW122_UWB::isAsyncMessageSend()
@@ -869,46 +1164,60 @@ bool RYUW122_UWB::isAsyncResponseExpected()
     }
     return false; // No message was sent
 }
+#endif
 
-const char* toString(RYUW122_Mode mode) {
+RYUW122_String toString(RYUW122_Mode mode) {
     switch (mode) {
-        case MODE_TAG: return "TAG";
-        case MODE_ANCHOR: return "ANCHOR";
-        case MODE_SLEEP: return "SLEEP";
-        case MODE_UNKNOWN: return "UNKNOWN";
-        default: return "INVALID_MODE";
+        case MODE_TAG: return RYUW122_TEXT("TAG");
+        case MODE_ANCHOR: return RYUW122_TEXT("ANCHOR");
+        case MODE_SLEEP: return RYUW122_TEXT("SLEEP");
+        case MODE_UNKNOWN: return RYUW122_TEXT("UNKNOWN");
+        default: return RYUW122_TEXT("INVALID_MODE");
     }
 }
 
-const char* toString(RYUW122_BaudRate baudRate) {
+RYUW122_String toString(RYUW122_BaudRate baudRate) {
     switch (baudRate) {
-        case BAUD_9600: return "9600";
-        case BAUD_57600: return "57600";
-        case BAUD_115200: return "115200";
-        case BAUD_UNKNOWN: return "UNKNOWN";
-        default: return "INVALID_BAUD";
+        case BAUD_9600: return RYUW122_TEXT("9600");
+        case BAUD_57600: return RYUW122_TEXT("57600");
+        case BAUD_115200: return RYUW122_TEXT("115200");
+        case BAUD_UNKNOWN: return RYUW122_TEXT("UNKNOWN");
+        default: return RYUW122_TEXT("INVALID_BAUD");
     }
 }
 
-const char* toString(RYUW122_Channel channel) {
+RYUW122_String toString(RYUW122_Channel channel) {
     switch (channel) {
-        case CHANNEL_6489_6_MHz: return "6489.6 MHz";
-        case CHANNEL_7987_2_MHz: return "7987.2 MHz";
-        case CHANNEL_UNKNOWN: return "UNKNOWN";
-        default: return "INVALID_CHANNEL";
+        case CHANNEL_6489_6_MHz: return RYUW122_TEXT("6489.6 MHz");
+        case CHANNEL_7987_2_MHz: return RYUW122_TEXT("7987.2 MHz");
+        case CHANNEL_UNKNOWN: return RYUW122_TEXT("UNKNOWN");
+        default: return RYUW122_TEXT("INVALID_CHANNEL");
     }
 }
 
-const char* toString(RYUW122_Bandwidth bandwidth) {
+RYUW122_String toString(RYUW122_Bandwidth bandwidth) {
     switch (bandwidth) {
-        case BANDWIDTH_850_Kbps: return "850 Kbps";
-        case BANDWIDTH_6_8_Mbps: return "6.8 Mbps";
-        case BANDWIDTH_UNKNOWN: return "UNKNOWN";
-        default: return "INVALID_BANDWIDTH";
+        case BANDWIDTH_850_Kbps: return RYUW122_TEXT("850 Kbps");
+        case BANDWIDTH_6_8_Mbps: return RYUW122_TEXT("6.8 Mbps");
+        case BANDWIDTH_UNKNOWN: return RYUW122_TEXT("UNKNOWN");
+        default: return RYUW122_TEXT("INVALID_BANDWIDTH");
+    }
+}
+
+RYUW122_String toString(RYUW122_Result result) {
+    switch (result) {
+        case RESULT_OK: return RYUW122_TEXT("OK");
+        case RESULT_NOT_EXECUTED: return RYUW122_TEXT("NOT_EXECUTED");
+        case RESULT_TIMEOUT: return RYUW122_TEXT("TIMEOUT");
+        case RESULT_MODULE_ERROR: return RYUW122_TEXT("MODULE_ERROR");
+        case RESULT_INVALID_ARGUMENT: return RYUW122_TEXT("INVALID_ARGUMENT");
+        case RESULT_PARSE_ERROR: return RYUW122_TEXT("PARSE_ERROR");
+        case RESULT_THROTTLED: return RYUW122_TEXT("THROTTLED");
+        default: return RYUW122_TEXT("INVALID_RESULT");
     }
 }
 
-const int toInt(RYUW122_BaudRate baudRate) {
+int toInt(RYUW122_BaudRate baudRate) {
     switch (baudRate) {
         case BAUD_9600: return 9600;
         case BAUD_57600: return 57600;
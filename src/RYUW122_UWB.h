@@ -8,6 +8,59 @@
 #define RYUW122_UWB_H
 
 #include <Arduino.h>
+#include "RYUW122_Address.h"
+
+/*
+  Build profile, selected with compiler flags (e.g. build_flags = -DRYUW122_PROFILE_TINY=1 in PlatformIO),
+  defines in a sketch do not reach the library sources.
+
+  RYUW122_PROFILE_TINY  Smaller defaults for AVR-class boards: 4 byte payloads, 1 queued message,
+                        toString() texts in flash
+  RYUW122_ANCHOR_ONLY   Leaves out the tag side (+TAG_RCV handling, tag response, RYUW122_TagWatchdog)
+  RYUW122_TAG_ONLY      Leaves out the anchor side (sending, async polling, ranging helpers) and the
+                        address and distance fields of RYUW122_MessageInfo
+*/
+#ifndef RYUW122_PROFILE_TINY
+#define RYUW122_PROFILE_TINY 0
+#endif
+
+#ifndef RYUW122_ANCHOR_ONLY
+#define RYUW122_ANCHOR_ONLY 0
+#endif
+
+#ifndef RYUW122_TAG_ONLY
+#define RYUW122_TAG_ONLY 0
+#endif
+
+#if RYUW122_ANCHOR_ONLY && RYUW122_TAG_ONLY
+#error "RYUW122_ANCHOR_ONLY and RYUW122_TAG_ONLY exclude each other"
+#endif
+
+#define RYUW122_HAS_ANCHOR (!RYUW122_TAG_ONLY)
+#define RYUW122_HAS_TAG (!RYUW122_ANCHOR_ONLY)
+
+#define RYUW122_MODULE_MAX_PAYLOAD 12 // Longest payload the module sends, whatever the host-side limit is
+
+#ifndef RYUW122_MAX_PAYLOAD
+#if RYUW122_PROFILE_TINY
+#define RYUW122_MAX_PAYLOAD 4  // Longer received payloads are truncated, longer messages are rejected
+#else
+#define RYUW122_MAX_PAYLOAD RYUW122_MODULE_MAX_PAYLOAD
+#endif
+#endif
+
+#if RYUW122_MAX_PAYLOAD < 1 || RYUW122_MAX_PAYLOAD > RYUW122_MODULE_MAX_PAYLOAD
+#error "RYUW122_MAX_PAYLOAD must be 1..12"
+#endif
+
+// Constant strings are kept in flash (PROGMEM) on every profile; toString() only in the tiny one,
+// where its texts are printable but not usable as const char *
+typedef const __FlashStringHelper *RYUW122_FlashString;
+#if RYUW122_PROFILE_TINY
+typedef RYUW122_FlashString RYUW122_String;
+#else
+typedef const char *RYUW122_String;
+#endif
 
 enum RYUW122_Mode : int8_t
 {
@@ -41,10 +94,14 @@ enum RYUW122_Bandwidth : int8_t
 
 struct RYUW122_MessageInfo
 {
+#if RYUW122_HAS_ANCHOR
     char address[9];        //8 chars + null terminator
+#endif
     uint8_t payloadLength;
-    char payload[13];       //12 chars + null terminator
+    char payload[RYUW122_MAX_PAYLOAD + 1]; //12 chars + null terminator
+#if RYUW122_HAS_ANCHOR
     uint16_t distance;
+#endif
 };
 
 enum RYUW122_MessageState : int8_t
@@ -54,14 +111,45 @@ enum RYUW122_MessageState : int8_t
     MESSAGE_WAITING        = -1,  // Waiting for async response
     MESSAGE_TIMEOUT        = -2,  // Timeout occurred
     MESSAGE_PARSE_ERROR    = -3,  // Response received but could not be parsed
-    MESSAGE_UNKNOWN        = -4   // Unknown or undefined state
+    MESSAGE_UNKNOWN        = -4,  // Unknown or undefined state
+    MESSAGE_ERROR          = -5   // Module rejected the request with +ERR=<n>
 };
 
-const char *toString(RYUW122_Mode mode);
-const char *toString(RYUW122_BaudRate rate);
-const char *toString(RYUW122_Channel channel);
-const char *toString(RYUW122_Bandwidth bandwidth);
-const int toInt(RYUW122_BaudRate baudRate);
+enum RYUW122_Result : int8_t
+{
+    RESULT_OK               =  1,  // Expected response received
+    RESULT_NOT_EXECUTED     =  0,  // No command was executed yet
+    RESULT_TIMEOUT          = -1,  // No expected response within the timeout
+    RESULT_MODULE_ERROR     = -2,  // Module replied with +ERR=<n>, see getLastErrorCode()
+    RESULT_INVALID_ARGUMENT = -3,  // Rejected by the library, nothing was sent
+    RESULT_PARSE_ERROR      = -4,  // Response received but could not be parsed
+    RESULT_THROTTLED        = -5   // Rejected by the rate governor, nothing was sent
+};
+
+struct RYUW122_RetryPolicy
+{
+    uint8_t maxRetries = 0;          // Additional attempts after the first one, 0 disables retrying
+    uint16_t initialBackoff = 10;    // Delay before the first retry [ms], doubled on every next retry
+    uint16_t maxBackoff = 200;       // Upper limit of the backoff delay [ms]
+    bool retryOnModuleError = false; // Retry +ERR responses too, not only timeouts
+};
+
+#ifndef RYUW122_RECEIVE_QUEUE_SIZE
+#if RYUW122_PROFILE_TINY
+#define RYUW122_RECEIVE_QUEUE_SIZE 1
+#else
+#define RYUW122_RECEIVE_QUEUE_SIZE 4 // Parsed messages kept when they arrive between reads, 0 disables the queue
+#endif
+#endif
+
+class RYUW122_RateGovernor;
+
+RYUW122_String toString(RYUW122_Mode mode);
+RYUW122_String toString(RYUW122_BaudRate rate);
+RYUW122_String toString(RYUW122_Channel channel);
+RYUW122_String toString(RYUW122_Bandwidth bandwidth);
+RYUW122_String toString(RYUW122_Result result);
+int toInt(RYUW122_BaudRate baudRate);
 
 class RYUW122_UWB
 {
@@ -72,10 +160,19 @@ public:
     bool isConnected();
     void reset();
     bool resetSW();
+    bool waitReady(uint16_t timeout = 0); // Waits for the READY line printed after a reset, 0 uses the module response timeout
+    int16_t getResetPin() const;
     void setModuleResponseTimeout(uint16_t timeout);
     void setDistanceResponseTimeout(uint16_t timeout);
     uint16_t getModuleResponseTimeout() const;
     uint16_t getDistanceResponseTimeout() const;
+    void setRetryPolicy(const RYUW122_RetryPolicy &policy);
+    const RYUW122_RetryPolicy &getRetryPolicy() const;
+    RYUW122_Result getLastResult() const;
+    int16_t getLastErrorCode() const;
+#if RYUW122_HAS_ANCHOR
+    void setRateGovernor(RYUW122_RateGovernor *governor); // Every poll is governed: a first send is rejected with RESULT_THROTTLED, sync retries wait for it
+#endif
 
     bool setMode(RYUW122_Mode mode);
     bool setBaudRate(RYUW122_BaudRate baudRate);
@@ -83,14 +180,29 @@ public:
     bool setBandwidth(RYUW122_Bandwidth bandwidth);
     bool setNetworkID(const char *networkID, size_t len = 0);
     bool setAddress(const char *address, size_t len = 0);
+    bool setAddress(const RYUW122_Address &address);
     bool setPassword(const char *password, size_t len = 0);
     bool setTagParameters(uint16_t enableTime = 0, uint16_t disableTime = 0);
+#if RYUW122_HAS_ANCHOR
     bool sendMessage(const char *address, const char *message, size_t addressLen = 0, size_t messageLen = 0, bool padToMaxLength = false, bool sendAsync = false);
+    bool sendMessage(const RYUW122_Address &address, const char *message, size_t messageLen = 0, bool padToMaxLength = false, bool sendAsync = false);
     bool sendMessageAsync(const char *address, const char *message, size_t addressLen = 0, size_t messageLen = 0, bool padToMaxLength = false);
+    bool sendMessageAsync(const RYUW122_Address &address, const char *message, size_t messageLen = 0, bool padToMaxLength = false);
+#endif
+#if RYUW122_HAS_TAG
     bool setTagResponseMessage(const char *message, size_t messageLen = 0, bool restart = false, bool padToMaxLength = false);
+#endif
     bool receiveMessage(RYUW122_MessageInfo &info, uint16_t timeout = 0);
+#if RYUW122_HAS_ANCHOR
     RYUW122_MessageState receiveMessageAsyncAnchor(RYUW122_MessageInfo &info);
+#endif
+#if RYUW122_HAS_TAG
     RYUW122_MessageState receiveMessageAsyncTag(RYUW122_MessageInfo &info);
+#endif
+    bool receiveNext(RYUW122_MessageInfo &info);
+    uint8_t getReceiveQueueCount() const;
+    uint32_t getReceiveOverflowCount() const;
+    void clearReceiveQueue();
     bool setCalibrationDistance(int8_t distance);
 
     bool getMode(RYUW122_Mode &mode);
@@ -105,10 +217,19 @@ public:
     bool getCalibrationDistance(int8_t &distance);
     bool getFirmwareVersion(char *buffer, size_t bufferSize);
 
+#if RYUW122_HAS_ANCHOR
     bool isAsyncMessageSend();
+#endif
 
 private:
-    static constexpr size_t MessageBufferSize = 50;
+    friend class RYUW122_UWBBenchmark; // extras/bench times the private encode / scan / parse stages
+
+    // Longest line the library handles: +ANCHOR_RCV=<8 chars>,<len>,<payload>,<distance> cm\r\n,
+    // or +CPIN=<32 chars>\r\n when that is longer. The module sends full payloads on every profile,
+    // RYUW122_MAX_PAYLOAD only limits what is copied into RYUW122_MessageInfo.
+    static constexpr size_t AnchorLineLength = 12 + 8 + 1 + 2 + 1 + RYUW122_MODULE_MAX_PAYLOAD + 1 + 8 + 2;
+    static constexpr size_t PasswordLineLength = 6 + 32 + 2;
+    static constexpr size_t MessageBufferSize = (AnchorLineLength > PasswordLineLength ? AnchorLineLength : PasswordLineLength) + 1;
     char messageBuffer[MessageBufferSize];
     const uint16_t resetTimeDelay = 5;      // Delay after waking up or reset the module
     const uint16_t afterResponseDelay = 5;  // Delay for commands thats save parameters in flash is required (module can be unresponsive for a while)
@@ -116,19 +237,73 @@ private:
     uint16_t distanceResponseTimeout = 200; // Timeout for distance response from module
     int16_t resetPin = -1;                  // Pin for hardware reset, -1 means no reset pin used
 
-    size_t indexAsyncMessage = 0;
+    RYUW122_RetryPolicy retryPolicy;
+    RYUW122_Result lastResult = RESULT_NOT_EXECUTED;
+    int16_t lastErrorCode = 0;              // Code from the last +ERR=<n> response, 0 if none
+#if RYUW122_HAS_ANCHOR
+    RYUW122_RateGovernor *rateGovernor = nullptr; // Optional polling rate limiter for the anchor send path
+#endif
+
+    char receiveLine[MessageBufferSize];        // Line assembled from unsolicited module output
+    size_t receiveLineIndex = 0;
+#if RYUW122_RECEIVE_QUEUE_SIZE > 0
+    RYUW122_MessageInfo receiveQueue[RYUW122_RECEIVE_QUEUE_SIZE];
+#endif
+    uint8_t receiveHead = 0;
+    uint8_t receiveCount = 0;
+    uint32_t receiveOverflowCount = 0;          // Messages dropped because the queue was full
+
+#if RYUW122_HAS_ANCHOR
     unsigned long expectedAsyncMessageTime = 0; // Last time a response was received
+    static constexpr size_t AsyncCommandSize = 8 + 4 + RYUW122_MAX_PAYLOAD + 1; // 8 chars address + ",12," + message + null terminator
+    char asyncCommand[AsyncCommandSize];        // Last async AT+ANCHOR_SEND value, kept for retries
+    RYUW122_Address asyncAddress;               // Tag polled by the pending async message
+    uint8_t asyncAttempt = 0;
+    unsigned long asyncRetryTime = 0;           // Time of the scheduled async retry, 0 if none
+#endif
 
     Stream &_serial;
-    void sendCommandWithValue(const char *cmd, const char *val, uint8_t valLength = 0);
-    void sendCommand(const char *cmd);
-    bool readResponse(const char *expectedResponse, uint32_t timeout);
-    bool readResponseAsync(const char *expectedResponse);
+    void sendCommandWithValue(RYUW122_FlashString cmd, const char *val, uint8_t valLength = 0);
+    void sendCommand(RYUW122_FlashString cmd);
+    RYUW122_Result executeCommand(RYUW122_FlashString cmd, const char *val = nullptr, uint8_t valLength = 0, RYUW122_FlashString expectedResponse = nullptr,
+                                  const RYUW122_Address *governedTag = nullptr); // nullptr expects "OK"; retries of a governed tag poll wait for the rate governor
+    RYUW122_Result readResponse(RYUW122_FlashString expectedResponse, uint32_t timeout, bool captureMessages = true);
+    bool getStringParameter(RYUW122_FlashString cmd, const char *prefix, char *buffer, size_t bufferSize, size_t expectedLen);
+    char *findParameter(const char *prefix);
+    bool parseErrorResponse(const char *response);
+    bool shouldRetry(RYUW122_Result result, uint8_t attempt) const;
+    uint16_t retryBackoff(uint8_t attempt) const;
+#if RYUW122_HAS_ANCHOR
+    RYUW122_MessageState retryAsyncMessage(RYUW122_MessageState failure);
+#endif
+    bool invalidArgument();
+    enum ReceiveKind : uint8_t
+    {
+        RECEIVE_ANY,
+        RECEIVE_ANCHOR,  // +ANCHOR_RCV, response to our poll
+        RECEIVE_TAG      // +TAG_RCV, poll received from an anchor
+    };
+
+    bool readReceiveLine();
+    bool appendReceiveLine(char c);
+    void clearReceiveLine();
+    void captureReceived();
+    static bool isMessageLine(const char *line);
+    bool queueReceivedLine(char *line);
+    void pushReceived(const RYUW122_MessageInfo &info);
+    bool popReceived(RYUW122_MessageInfo &info, ReceiveKind kind, const RYUW122_Address &address = RYUW122_Address());
+#if RYUW122_HAS_ANCHOR
+    RYUW122_MessageState completeAsyncMessage(bool success);
     bool parseAnchorResponse(char *response, RYUW122_MessageInfo &info);
+#endif
+#if RYUW122_HAS_TAG
     bool parseTagResponse(char *response, RYUW122_MessageInfo &info);
+#endif
     void clearMessageBuffer();
+#if RYUW122_HAS_ANCHOR
     void resetAsyncMessage();
     bool isAsyncResponseExpected();
+#endif
 };
 
 #endif // RYUW122_UWB_H
\ No newline at end of file